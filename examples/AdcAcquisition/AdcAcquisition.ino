@@ -0,0 +1,55 @@
+#include <Wire.h>
+#include "bq25155.h"
+
+// Pin setup
+static constexpr uint8_t BQ_CHEN = 2;  // Charge enable pin
+static constexpr uint8_t BQ_INT  = 5;  // Interrupt pin (open-drain, needs a pull-up)
+static constexpr uint8_t BQ_LPM  = 20; // Low power mode pin
+static constexpr BatteryChemistry BQ_CHEM = LI_ION_4V2;
+static constexpr bool BQ_USE_PG_LED = true;
+
+bq25155 charger;
+
+static void onFrame(const AdcSnapshot &adc, void *context) {
+  (void)context;
+  Serial.print("VBAT: ");
+  Serial.print(adc.vbat_mV);
+  Serial.print(" mV, VIN: ");
+  Serial.print(adc.vin_mV);
+  Serial.print(" mV, TS: ");
+  Serial.print(adc.ts_mV);
+  Serial.println(" mV");
+}
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial) { delay(10); }
+
+  if (!charger.begin(BQ_CHEN, BQ_INT, BQ_LPM, BQ_CHEM, BQ_USE_PG_LED)) {
+    Serial.println("bq25155 not found!");
+    while (1) { delay(1000); }
+  }
+
+  ChargeProfile profile;
+  if (!charger.applyChargeProfile(profile)) {
+    Serial.println("Failed to apply charge profile");
+    while (1) { delay(1000); }
+  }
+
+  // Manual read rate: each acquisition triggers exactly one conversion.
+  charger.ADCManualRead();
+  charger.EnableAllADCCh();
+
+  if (!charger.enableInterrupt()) {
+    Serial.println("INT pin has no interrupt; frames arrive by the polling fallback");
+  }
+  charger.startAdcAcquisition(onFrame);
+}
+
+void loop() {
+  // ADC_READY completes the acquisition from service(); no delay for the conversion time.
+  charger.service();
+  if (charger.adcAcquisitionReady()) {
+    charger.startAdcAcquisition(onFrame);
+  }
+}
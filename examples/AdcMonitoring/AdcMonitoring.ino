@@ -71,14 +71,21 @@ void setup() {
 void loop() {
   charger.enforceSafetyFaultPolicy();
 
-  printMilli("VIN", charger.readVIN(0));
-  printMilli("PMID", charger.readPMID(0));
-  printMilli("VBAT", charger.readVBAT(0));
-  printMilli("TS", charger.readTS(0));
-  printMilli("ADCIN", charger.readADCIN(0));
+  // One burst for all seven channels (same conversion set, no torn MSB/LSB pairs).
+  // Single-channel readers (readVBAT(0), readVIN(0), ...) are still available.
+  AdcSnapshot adc = charger.readAdcSnapshot(0);
+  if (!adc.valid) {
+    Serial.println("ADC snapshot read failed");
+  } else {
+    printMilli("VIN", adc.vin_mV);
+    printMilli("PMID", adc.pmid_mV);
+    printMilli("VBAT", adc.vbat_mV);
+    printMilli("TS", adc.ts_mV);
+    printMilli("ADCIN", adc.adcin_mV);
 
-  printMicroAsMilli("IIN", charger.readIIN(0));
-  printPercentScaled("ICHG (percent of ICHG setting)", charger.readICHG(0));
+    printMicroAsMilli("IIN", adc.iin_uA);
+    printPercentScaled("ICHG (percent of ICHG setting)", adc.ichg_pct);
+  }
 
   Serial.println("--------------------");
   delay(2000);
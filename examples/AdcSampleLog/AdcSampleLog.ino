@@ -0,0 +1,61 @@
+#include <Wire.h>
+#include "bq25155.h"
+
+// Pin setup
+static constexpr uint8_t BQ_CHEN = 2;  // Charge enable pin
+static constexpr uint8_t BQ_INT  = 5;  // Interrupt pin (open-drain, needs a pull-up)
+static constexpr uint8_t BQ_LPM  = 20; // Low power mode pin
+static constexpr BatteryChemistry BQ_CHEM = LI_ION_4V2;
+static constexpr bool BQ_USE_PG_LED = true;
+
+bq25155 charger;
+
+// Every frame the driver reads lands here with its timestamp; the logger drains it later
+// without touching the bus. Power-of-two capacity, no heap.
+static AdcSampleRing<16> samples;
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial) { delay(10); }
+
+  if (!charger.begin(BQ_CHEN, BQ_INT, BQ_LPM, BQ_CHEM, BQ_USE_PG_LED)) {
+    Serial.println("bq25155 not found!");
+    while (1) { delay(1000); }
+  }
+
+  ChargeProfile profile;
+  if (!charger.applyChargeProfile(profile)) {
+    Serial.println("Failed to apply charge profile");
+    while (1) { delay(1000); }
+  }
+
+  charger.ADCManualRead();
+  charger.EnableAllADCCh();
+  charger.attachAdcSampleRing(samples);
+  charger.enableInterrupt();
+  charger.startAdcAcquisition();
+}
+
+void loop() {
+  // Producer: one frame per ADC_READY.
+  charger.service();
+  if (charger.adcAcquisitionReady()) {
+    charger.startAdcAcquisition();
+  }
+
+  // Consumer: print whatever arrived since the last second.
+  static unsigned long lastLogMs = 0;
+  if (millis() - lastLogMs >= 1000) {
+    lastLogMs = millis();
+    AdcSample s;
+    while (samples.pop(s)) {
+      Serial.print(s.timestampUs);
+      Serial.print(" us  VBAT raw: 0x");
+      Serial.println(s.raw[(uint8_t)AdcChannel::VBAT], HEX);
+    }
+    if (samples.dropped() != 0) {
+      Serial.print("Dropped: ");
+      Serial.println(samples.dropped());
+    }
+  }
+}
@@ -0,0 +1,73 @@
+#include <Wire.h>
+#include "bq25155.h"
+
+// Pin setup
+static constexpr uint8_t BQ_CHEN = 2;  // Charge enable pin
+static constexpr uint8_t BQ_INT  = 5;  // Interrupt pin (open-drain, needs a pull-up)
+static constexpr uint8_t BQ_LPM  = 20; // Low power mode pin
+static constexpr BatteryChemistry BQ_CHEM = LI_ION_4V2;
+static constexpr bool BQ_USE_PG_LED = true;
+
+bq25155 charger;
+
+static void onChargeEvent(ChargerEvent event, void *context) {
+  (void)context;
+  switch (event) {
+    case ChargerEvent::VIN_PGOOD:   Serial.println("VIN power good changed"); break;
+    case ChargerEvent::CHARGE_DONE: Serial.println("Charge done"); break;
+    case ChargerEvent::TS_HOT:      Serial.println("Battery hot"); break;
+    case ChargerEvent::TS_COLD:     Serial.println("Battery cold"); break;
+    default: break;
+  }
+}
+
+static void onAdcReady(ChargerEvent, void *context) {
+  bq25155 *dev = static_cast<bq25155 *>(context);
+  AdcSnapshot adc = dev->readAdcSnapshot(0);
+  Serial.print("VBAT: ");
+  Serial.print(adc.vbat_mV);
+  Serial.println(" mV");
+}
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial) { delay(10); }
+
+  if (!charger.begin(BQ_CHEN, BQ_INT, BQ_LPM, BQ_CHEM, BQ_USE_PG_LED)) {
+    Serial.println("bq25155 not found!");
+    while (1) { delay(1000); }
+  }
+
+  ChargeProfile profile;
+  if (!charger.applyChargeProfile(profile)) {
+    Serial.println("Failed to apply charge profile");
+    while (1) { delay(1000); }
+  }
+
+  charger.onEvent(ChargerEvent::VIN_PGOOD, onChargeEvent);
+  charger.onEvent(ChargerEvent::CHARGE_DONE, onChargeEvent);
+  charger.onEvent(ChargerEvent::TS_HOT, onChargeEvent);
+  charger.onEvent(ChargerEvent::TS_COLD, onChargeEvent);
+  charger.onEvent(ChargerEvent::ADC_READY, onAdcReady, &charger);
+
+  // Only unmasked flags pulse INT: unmask exactly the events handled above (one burst write).
+  const uint32_t handled =
+      bq25155_const::eventBit(ChargerEvent::VIN_PGOOD) |
+      bq25155_const::eventBit(ChargerEvent::CHARGE_DONE) |
+      bq25155_const::eventBit(ChargerEvent::TS_HOT) |
+      bq25155_const::eventBit(ChargerEvent::TS_COLD) |
+      bq25155_const::eventBit(ChargerEvent::ADC_READY);
+  charger.setInterruptMasks(~handled);
+
+  charger.ADC1sSamp();
+  charger.EnableAllADCCh();
+
+  if (!charger.enableInterrupt()) {
+    Serial.println("INT pin has no interrupt; falling back to polling");
+  }
+}
+
+void loop() {
+  // No I2C traffic unless INT fired. Use charger.service(true) to poll instead.
+  charger.service();
+}
@@ -0,0 +1,271 @@
+/*
+ * @brief         Host benchmark of bq25155 high-level operations
+ * @note          Runs the real driver against the register-level simulator and reports
+ *                I2C transactions, wire bytes, LPM edges and bus time at 100 kHz,
+ *                400 kHz and 1 MHz for each operation.
+ *
+ *                Build and run from the repository root:
+ *                  g++ -std=gnu++11 -O2 -Isrc -Iextras/sim \
+ *                      -DBQ25155_TRANSPORT_HEADER='"bq25155_sim_bus.h"' \
+ *                      -DBQ25155_TRANSPORT=bq25155_sim::SimBus \
+ *                      extras/bench/bq25155_bench.cpp src/bq25155.cpp src/bq25155_port.cpp \
+ *                      extras/sim/bq25155_sim.cpp -o bq25155_bench
+ *                  ./bq25155_bench                                  # print table
+ *                  ./bq25155_bench --compare extras/bench/baseline.txt
+ *
+ *                --compare exits with status 1 when any operation needs more transactions
+ *                or bytes than the baseline. Regenerate the baseline with
+ *                  ./bq25155_bench > extras/bench/baseline.txt
+ * @version       1.1.4
+ * @creation date 2026-03-09
+ * @updated date  2026-03-09
+ * @author        jul10199555
+ *
+ * Repo:
+ * https://github.com/jul10199555/bq25155-Arduino-Library
+ *
+ */
+
+#include "bq25155_sim.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace bq25155_sim;
+
+static constexpr uint8_t PIN_CHEN = 2;
+static constexpr uint8_t PIN_INT = 5;
+static constexpr uint8_t PIN_LPM = 20;
+
+static Bq25155Sim sim;
+static uint32_t lpmEdges = 0;
+
+// Pins and clock of the host port are routed to the simulator.
+namespace bq25155_port {
+void pinMode(uint8_t, uint8_t) {}
+void digitalWrite(uint8_t pin, uint8_t value) {
+    if (pin == PIN_CHEN) { sim.setCEPin(value != LOW); }
+    if (pin == PIN_LPM) {
+        sim.setLPMPin(value != LOW);
+        lpmEdges++;
+    }
+}
+int digitalRead(uint8_t pin) { return (pin == PIN_INT && sim.intAsserted()) ? LOW : HIGH; }
+unsigned long millis() { return (unsigned long)(sim.nowUs() / 1000ULL); }
+unsigned long micros() { return (unsigned long)sim.nowUs(); }
+void delay(unsigned long ms) { sim.advance((uint32_t)(ms * 1000UL)); }
+} // namespace bq25155_port
+
+struct Result {
+    std::string name;
+    uint32_t transactions;
+    uint32_t bytes;
+    uint32_t lpm;
+    uint64_t bits;
+};
+
+static std::vector<Result> results;
+
+template <typename Op>
+static void measure(bq25155 &charger, const char *name, Op op) {
+    SimBus &bus = charger.transport();
+    bus.resetCounters();
+    lpmEdges = 0;
+    op();
+    const BusCounters &c = bus.counters();
+    results.push_back(Result{name, c.transactions, c.bytes, lpmEdges, c.bits});
+}
+
+#define MASK_OP(fn) measure(charger, #fn, [&]() { charger.fn(true); })
+
+static void runBenchmarks() {
+    sim.setVIN(5000);
+    sim.setBatteryOCV(3700);
+
+    // Bus time is derived from bit counts; keep simulated time still during transfers.
+    bq25155 charger(SimBus(&sim, 0));
+
+    measure(charger, "begin", [&]() { charger.begin(PIN_CHEN, PIN_INT, PIN_LPM); });
+
+    ChargeProfile profile;
+    measure(charger, "applyChargeProfile", [&]() { charger.applyChargeProfile(profile); });
+    measure(charger, "applyChargeProfile_again", [&]() { charger.applyChargeProfile(profile); });
+    using Fixed = StaticChargeProfile<4200, true, 100000, 20000, ILIMLevel::ILIM_200mA>;
+    measure(charger, "applyChargeImage_again", [&]() { charger.applyChargeImage(Fixed::image()); });
+
+    // MCU-only reset: a second driver instance finds the configuration it saved.
+    const uint32_t checksum = charger.getConfigChecksum();
+    bq25155 rebooted(SimBus(&sim, 0));
+    measure(rebooted, "begin_resume", [&]() {
+        rebooted.begin(PIN_CHEN, PIN_INT, PIN_LPM, LI_ION_4V2, true, checksum);
+    });
+
+    measure(charger, "EnableFastCharge", [&]() { charger.EnableFastCharge(); });
+    measure(charger, "setChargeVoltage", [&]() { charger.setChargeVoltage(4150); });
+    charger.setChargeReconfigMode(ChargeReconfigMode::STAGED_WINDOW);
+    measure(charger, "setChargeVoltage_staged_window", [&]() { charger.setChargeVoltage(4200); });
+    charger.setChargeReconfigMode(ChargeReconfigMode::PER_CALL);
+
+    charger.ADC1sSamp();
+    charger.EnableAllADCCh();
+    sim.advance(2000000);
+    measure(charger, "adc_frame_snapshot", [&]() { charger.readAdcSnapshot(0); });
+    measure(charger, "adc_frame_7_readers", [&]() {
+        charger.readVBAT(0);
+        charger.readTS(0);
+        charger.readICHG(0);
+        charger.readADCIN(0);
+        charger.readVIN(0);
+        charger.readPMID(0);
+        charger.readIIN(0);
+    });
+    AdcFilterBank<bq25155_filter::Median<5>> filtered;
+    measure(charger, "adc_frame_filtered_scaled", [&]() {
+        filtered.updateFrame(charger.readAdcSnapshot(0));
+        uint16_t raw[bq25155_const::ADC_CHANNEL_COUNT];
+        filtered.values(raw);
+        charger.scaleAdcFrame(raw, 0);
+    });
+
+    charger.ADCManualRead();
+    charger.readAllFLAGS(); // INT idle before the acquisition
+    measure(charger, "adc_acquisition_int", [&]() {
+        charger.startAdcAcquisition();
+        bool intLevel = sim.intAsserted();
+        while (!charger.adcAcquisitionReady()) {
+            sim.advance(1000);
+            if (sim.intAsserted() && !intLevel) { charger.markInterruptPending(); } // FALLING edge
+            intLevel = sim.intAsserted();
+        }
+    });
+    charger.ADC1sSamp();
+
+    measure(charger, "status_16_accessors", [&]() {
+        charger.is_CHRG_CV();
+        charger.is_CHARGE_DONE();
+        charger.is_IINLIM_EN();
+        charger.is_VDPPM_EN();
+        charger.is_VINDPM_EN();
+        charger.is_THERMREG_EN();
+        charger.is_VIN_PGOOD();
+        charger.is_VIN_OVP_TRIG();
+        charger.is_BAT_OCP_TRIG();
+        charger.is_BAT_UVLO();
+        charger.is_BAT_COLD();
+        charger.is_BAT_COOL();
+        charger.is_BAT_WARM();
+        charger.is_BAT_HOT();
+        charger.is_Alarm_TRIG(AlarmComparator::COMP1);
+        charger.is_TS_OPEN();
+    });
+    measure(charger, "readStatus", [&]() { charger.readStatus(); });
+    measure(charger, "readStatus_with_flags", [&]() { charger.readStatus(true); });
+
+    charger.getChargeStatus();
+    measure(charger, "getChargeStatus_steady", [&]() { charger.getChargeStatus(); });
+
+    measure(charger, "readAllFLAGS+enforceSafetyFaultPolicy", [&]() {
+        charger.readAllFLAGS();
+        charger.enforceSafetyFaultPolicy();
+    });
+    measure(charger, "enforceSafetyFaultPolicy_refresh", [&]() {
+        charger.enforceSafetyFaultPolicy(nullptr, true);
+    });
+
+    charger.addFaultRule({ChargerEvent::TS_COOL, FaultSource::STATUS,
+                          FaultAction::SCALE_CHARGE_CURRENT, 3, 3, 50});
+    charger.addFaultRule({ChargerEvent::TS_COLD, FaultSource::STATUS,
+                          FaultAction::DISABLE_CHARGE, 1, 3, 0});
+    measure(charger, "evaluateFaultRules", [&]() { charger.evaluateFaultRules(); });
+    charger.clearFaultRules();
+
+    MASK_OP(set_CHRG_CV_MASK);
+    MASK_OP(set_CHARGE_DONE_MASK);
+    MASK_OP(set_IINLIM_ACTIVE_MASK);
+    MASK_OP(set_VDPPM_ACTIVE_MASK);
+    MASK_OP(set_VINDPM_ACTIVE_MASK);
+    MASK_OP(set_THERMREG_ACTIVE_MASK);
+    MASK_OP(set_VIN_PGOOD_MASK);
+    MASK_OP(set_VIN_OVP_FAULT_MASK);
+    MASK_OP(set_BAT_OCP_FAULT_MASK);
+    MASK_OP(set_BAT_UVLO_FAULT_MASK);
+    MASK_OP(set_TS_COLD_MASK);
+    MASK_OP(set_TS_COOL_MASK);
+    MASK_OP(set_TS_WARM_MASK);
+    MASK_OP(set_TS_HOT_MASK);
+    MASK_OP(set_ADC_READY_MASK);
+    MASK_OP(set_COMP1_ALARM_MASK);
+    MASK_OP(set_COMP2_ALARM_MASK);
+    MASK_OP(set_COMP3_ALARM_MASK);
+    MASK_OP(set_TS_OPEN_MASK);
+    MASK_OP(set_WD_FAULT_MASK);
+    MASK_OP(set_SAFETY_TMR_FAULT_MASK);
+    MASK_OP(set_LDO_OCP_FAULT_MASK);
+    MASK_OP(set_MRWAKE1_TIMEOUT_MASK);
+    MASK_OP(set_MRWAKE2_TIMEOUT_MASK);
+    MASK_OP(set_MRRESET_WARN_MASK);
+
+    measure(charger, "checkForChipReset_steady", [&]() { charger.checkForChipReset(); });
+    sim.registerReset();
+    measure(charger, "checkForChipReset_restore", [&]() { charger.checkForChipReset(); });
+
+    charger.enableWatchdogKeeper();
+    measure(charger, "service_idle_watchdog_fed", [&]() { charger.service(); });
+    sim.advance(charger.msUntilKeepAlive() * 1000UL);
+    measure(charger, "service_idle_watchdog_due", [&]() { charger.service(); });
+}
+
+static void printTable() {
+    std::printf("# %-40s %6s %6s %4s %8s %8s %8s\n", "operation", "tx", "bytes", "lpm",
+                "us@100k", "us@400k", "us@1M");
+    for (const Result &r : results) {
+        BusCounters c = BusCounters();
+        c.bits = r.bits;
+        std::printf("%-42s %6u %6u %4u %8llu %8llu %8llu\n", r.name.c_str(), r.transactions,
+                    r.bytes, r.lpm, (unsigned long long)c.busTimeUs(100000),
+                    (unsigned long long)c.busTimeUs(400000), (unsigned long long)c.busTimeUs(1000000));
+    }
+}
+
+static int compareWith(const char *path) {
+    FILE *f = std::fopen(path, "r");
+    if (f == nullptr) {
+        std::fprintf(stderr, "cannot open %s\n", path);
+        return 2;
+    }
+
+    int regressions = 0;
+    char line[256];
+    while (std::fgets(line, sizeof(line), f) != nullptr) {
+        if (line[0] == '#' || line[0] == '\n') { continue; }
+        char name[128];
+        unsigned tx = 0, bytes = 0;
+        if (std::sscanf(line, "%127s %u %u", name, &tx, &bytes) != 3) { continue; }
+
+        for (const Result &r : results) {
+            if (r.name != name) { continue; }
+            const char *verdict = "same";
+            if (r.transactions > tx || r.bytes > bytes) {
+                verdict = "REGRESSION";
+                regressions++;
+            } else if (r.transactions < tx || r.bytes < bytes) {
+                verdict = "improved";
+            }
+            std::printf("%-42s tx %4u -> %4u  bytes %5u -> %5u  %s\n", name, tx, r.transactions,
+                        bytes, r.bytes, verdict);
+        }
+    }
+    std::fclose(f);
+    return (regressions != 0) ? 1 : 0;
+}
+
+int main(int argc, char **argv) {
+    runBenchmarks();
+    if (argc == 3 && std::strcmp(argv[1], "--compare") == 0) {
+        return compareWith(argv[2]);
+    }
+    printTable();
+    return 0;
+}
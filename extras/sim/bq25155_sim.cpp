@@ -0,0 +1,555 @@
+/*
+ * @brief         Host-side register-level simulator of the bq25155
+ * @note          See bq25155_sim.h for what is (and is not) modeled.
+ * @version       1.1.4
+ * @creation date 2026-03-09
+ * @updated date  2026-03-09
+ * @author        jul10199555
+ *
+ * Repo:
+ * https://github.com/jul10199555/bq25155-Arduino-Library
+ *
+ */
+
+#include "bq25155_sim.h"
+
+using namespace bq25155_const;
+
+namespace bq25155_sim {
+
+// Battery model: OCV rises 1200 mV over one full capacity of charge.
+static constexpr double OCV_SPAN_MV = 1200.0;
+// Longest battery integration step inside advance().
+static constexpr uint32_t MAX_STEP_US = 100000;
+
+static constexpr uint16_t ILIM_TABLE_MA[8] = {50, 100, 150, 200, 300, 400, 500, 600};
+static constexpr uint16_t BUVLO_TABLE_MV[8] = {3000, 3000, 3000, 2800, 2600, 2400, 2200, 0};
+static constexpr uint16_t TS_ICHRG_PERMILLE[8] = {1000, 875, 750, 625, 500, 375, 250, 125};
+static constexpr uint32_t SAFETY_TIMER_S[4] = {3UL * 3600UL, 6UL * 3600UL, 12UL * 3600UL, 0};
+
+// Data register (MSB) for each ADC_COMPx channel code, 0 = disabled.
+static constexpr uint8_t COMP_CHANNEL_REG[8] = {
+    0,
+    REG_ADC_DATA_ADCIN_M, REG_ADC_DATA_TS_M, REG_ADC_DATA_VBAT_M, REG_ADC_DATA_ICHG_M,
+    REG_ADC_DATA_VIN_M, REG_ADC_DATA_PMID_M, REG_ADC_DATA_IIN_M
+};
+// ADC_READ_EN bit for each ADC_COMPx channel code.
+static constexpr uint8_t COMP_CHANNEL_EN[8] = {
+    0,
+    EN_ADCIN_READ_MASK, EN_TS_READ_MASK, EN_VBAT_READ_MASK, EN_ICHG_READ_MASK,
+    EN_VIN_READ_MASK, EN_PMID_READ_MASK, EN_IIN_READ_MASK
+};
+static constexpr uint8_t COMP_STAT_MASK[3] = {COMP1_ALARM_STAT_MASK, COMP2_ALARM_STAT_MASK, COMP3_ALARM_STAT_MASK};
+
+static bool isWritable(uint8_t reg) {
+    for (uint8_t i = 0; i < SHADOW_RANGE_COUNT; i++) {
+        if (reg >= SHADOW_RANGES[i].first && reg <= SHADOW_RANGES[i].last) { return true; }
+    }
+    return false;
+}
+
+static bool isFlagRegister(uint8_t reg) {
+    return (reg >= REG_FLAG_0 && reg <= REG_FLAG_3);
+}
+
+// --- Bq25155Sim ---
+
+Bq25155Sim::Bq25155Sim()
+    : _nowUs(0), _vin_mV(5000), _ocv_mV(3700.0), _capacity_mAh(0), _rbat_mOhm(100),
+      _ts_mV(400), _adcin_mV(0), _sysLoad_uA(0), _ceHigh(false), _lpmHigh(true), _forceOCP(false),
+      _phase(ChargePhase::NO_INPUT), _ichg_uA(0), _iin_uA(0), _ichgRef_uA(0), _vbatTerm_mV(3700),
+      _chargeStartUs(0), _timerExpired(false),
+      _adcBusy(false), _adcDoneUs(0), _adcNextUs(0), _adcSweeps(0), _regWrites(0) {
+    resetRegisters();
+    updateStatus();
+}
+
+void Bq25155Sim::resetRegisters() {
+    for (uint16_t i = 0; i < 256; i++) { _regs[i] = 0x00; }
+
+    _regs[REG_MASK_2] = MASK2_DEF;
+    _regs[REG_VBAT_CTRL] = VBAT_REG_DEF;
+    _regs[REG_ICHG_CTRL] = ICHG_CTRL_DEF;
+    _regs[REG_PCHRGCTRL] = IPRECHG_DEF;
+    _regs[REG_TERMCTRL] = ITERM_DEF;
+    _regs[REG_CHARGERCTRL0] = CHARGERCTRL0_DEF;
+    _regs[REG_CHARGERCTRL1] = CHARGERCTRL1_DEF;
+    _regs[REG_ILIMCTRL] = ILIM_100MA;
+    _regs[REG_LDOCTRL] = LDOCTRL_DEF;
+    _regs[REG_MRCTRL] = MRCTRL_DEF;
+    _regs[REG_ICCTRL0] = ICCTRL0_DEF;
+    _regs[REG_ICCTRL2] = ICCTRL2_DEF;
+    _regs[REG_ADCCTRL0] = ADCCTRL0_DEF;
+    _regs[REG_ADCCTRL1] = ADCCTRL1_DEF;
+    _regs[REG_ADCALARM_COMP1_M] = ADCALARM_COMP1_M_DEF;
+    _regs[REG_ADCALARM_COMP1_L] = ADCALARM_COMP1_L_DEF;
+    _regs[REG_ADCALARM_COMP2_M] = ADCALARM_COMP2_M_DEF;
+    _regs[REG_ADCALARM_COMP2_L] = ADCALARM_COMP2_L_DEF;
+    _regs[REG_TS_FASTCHGCTRL] = TS_FASTCHGCTRL_DEF;
+    _regs[REG_TS_COLD] = TS_COLD_DEF;
+    _regs[REG_TS_COOL] = TS_COOL_DEF;
+    _regs[REG_TS_WARM] = TS_WARM_DEF;
+    _regs[REG_TS_HOT] = TS_HOT_DEF;
+    _regs[REG_DEVICE_ID] = DEVICE_ID_DEF;
+
+    _adcBusy = false;
+    _adcNextUs = _nowUs + adcPeriodUs();
+    _chargeStartUs = _nowUs;
+    _timerExpired = false;
+    if (_phase == ChargePhase::DONE || _phase == ChargePhase::TIMER_FAULT) {
+        _phase = ChargePhase::DISABLED; // Re-evaluated by updateStatus()
+    }
+}
+
+void Bq25155Sim::registerReset() {
+    resetRegisters();
+    updateStatus();
+    // The reset itself is not an event: start with clean flags.
+    for (uint8_t reg = REG_FLAG_0; reg <= REG_FLAG_3; reg++) { _regs[reg] = 0x00; }
+}
+
+// --- Analog and pin side ---
+
+void Bq25155Sim::setVIN(uint16_t mV) { _vin_mV = mV; updateStatus(); }
+void Bq25155Sim::setBatteryOCV(uint16_t mV) { _ocv_mV = mV; updateStatus(); }
+void Bq25155Sim::setBatteryCapacity(uint16_t mAh) { _capacity_mAh = mAh; }
+void Bq25155Sim::setBatteryResistance(uint16_t mOhm) { _rbat_mOhm = mOhm; updateStatus(); }
+void Bq25155Sim::setTS(uint16_t mV) { _ts_mV = mV; updateStatus(); }
+void Bq25155Sim::setADCIN(uint16_t mV) { _adcin_mV = mV; }
+void Bq25155Sim::setSystemLoad(uint32_t uA) { _sysLoad_uA = uA; updateStatus(); }
+void Bq25155Sim::setCEPin(bool high) { _ceHigh = high; updateStatus(); }
+void Bq25155Sim::setLPMPin(bool high) { _lpmHigh = high; }
+void Bq25155Sim::setBatteryOCP(bool active) { _forceOCP = active; updateStatus(); }
+
+bool Bq25155Sim::intAsserted() const {
+    if ((_regs[REG_ICCTRL0] & GLOBAL_INT_MASK) != 0) { return false; }
+    uint8_t pending = 0;
+    for (uint8_t i = 0; i < 4; i++) {
+        pending |= (uint8_t)(_regs[REG_FLAG_0 + i] & ~_regs[REG_MASK_0 + i]);
+    }
+    return (pending != 0);
+}
+
+bool Bq25155Sim::i2cAvailable() const {
+    return _lpmHigh || ((_regs[REG_STAT_0] & VIN_PGOOD_STAT_MASK) != 0);
+}
+
+// --- Time ---
+
+void Bq25155Sim::advance(uint32_t us) {
+    while (us > 0) {
+        uint32_t step = (us > MAX_STEP_US) ? MAX_STEP_US : us;
+
+        // Stop exactly on the next ADC event so conversions land at the right time.
+        uint64_t nextEvent = 0;
+        if (_adcBusy) {
+            nextEvent = _adcDoneUs;
+        } else if (adcPeriodUs() != 0) {
+            nextEvent = _adcNextUs;
+        }
+        if (nextEvent > _nowUs && (nextEvent - _nowUs) < step) {
+            step = (uint32_t)(nextEvent - _nowUs);
+        }
+
+        integrateBattery(step);
+        _nowUs += step;
+        us -= step;
+
+        if (_adcBusy && _nowUs >= _adcDoneUs) {
+            finishAdcSweep();
+        }
+        const uint64_t period = adcPeriodUs();
+        if (!_adcBusy && period != 0 && _nowUs >= _adcNextUs) {
+            startAdcSweep();
+            _adcNextUs += period;
+            if (_adcNextUs <= _nowUs) { _adcNextUs = _nowUs + period; }
+        }
+        updateStatus();
+    }
+}
+
+void Bq25155Sim::integrateBattery(uint32_t us) {
+    if (_capacity_mAh == 0 || _ichg_uA == 0) { return; }
+    const double mAh = (double)_ichg_uA * (double)us / 3.6e12;
+    _ocv_mV += mAh * OCV_SPAN_MV / (double)_capacity_mAh;
+}
+
+// --- Register side ---
+
+bool Bq25155Sim::write(uint8_t reg, const uint8_t *data, uint8_t len) {
+    if (!i2cAvailable()) { return false; }
+    for (uint8_t i = 0; i < len; i++) {
+        applyWrite((uint8_t)(reg + i), data[i]);
+    }
+    _regWrites += len;
+    updateStatus();
+    return true;
+}
+
+bool Bq25155Sim::read(uint8_t reg, uint8_t *buf, uint8_t len) {
+    if (!i2cAvailable()) { return false; }
+    for (uint8_t i = 0; i < len; i++) {
+        const uint8_t r = (uint8_t)(reg + i);
+        buf[i] = _regs[r];
+        if (isFlagRegister(r)) { _regs[r] = 0x00; } // Clear on read
+    }
+    return true;
+}
+
+void Bq25155Sim::poke(uint8_t reg, uint8_t value) {
+    _regs[reg] = value;
+    updateStatus();
+}
+
+void Bq25155Sim::applyWrite(uint8_t reg, uint8_t value) {
+    if (!isWritable(reg)) { return; } // Read-only or reserved: ignored
+
+    if (reg == REG_ICCTRL0 && (value & (HW_RESET_MASK | SW_RESET_MASK)) != 0) {
+        registerReset();
+        return;
+    }
+
+    if (reg == REG_ADCCTRL0) {
+        const uint8_t oldRate = _regs[REG_ADCCTRL0] & ADC_READ_RATE_MASK;
+        // CONV_START reads back as 1 only while a conversion is running.
+        _regs[reg] = (uint8_t)((value & ~ADC_CONV_START_MASK) |
+                               (_regs[reg] & ADC_CONV_START_MASK));
+        if ((value & ADC_READ_RATE_MASK) != oldRate) {
+            _adcNextUs = _nowUs + adcPeriodUs();
+        }
+        if ((value & ADC_CONV_START_MASK) != 0 && !_adcBusy) {
+            startAdcSweep();
+        }
+        return;
+    }
+
+    _regs[reg] = value;
+}
+
+// --- Charger state machine and status ---
+
+uint32_t Bq25155Sim::fastChargeCurrent_uA() const {
+    const uint32_t step = (_regs[REG_PCHRGCTRL] & ICHARGE_RANGE_MASK) ? 2500UL : 1250UL;
+    uint32_t uA = _regs[REG_ICHG_CTRL] * step;
+    return (step == 2500UL && uA > 500000UL) ? 500000UL : uA;
+}
+
+uint32_t Bq25155Sim::prechargeCurrent_uA() const {
+    const uint32_t step = (_regs[REG_PCHRGCTRL] & ICHARGE_RANGE_MASK) ? 2500UL : 1250UL;
+    return (_regs[REG_PCHRGCTRL] & IPRECHG_MASK) * step;
+}
+
+uint32_t Bq25155Sim::inputLimit_uA() const {
+    return ILIM_TABLE_MA[_regs[REG_ILIMCTRL] & ILIM_MASK] * 1000UL;
+}
+
+uint16_t Bq25155Sim::regulationVoltage_mV() const {
+    return (uint16_t)(3600 + (_regs[REG_VBAT_CTRL] & VBAT_REG_MASK) * 10);
+}
+
+void Bq25155Sim::updateStatus() {
+    const uint8_t old0 = _regs[REG_STAT_0];
+    const uint8_t old1 = _regs[REG_STAT_1];
+    const uint8_t old2 = _regs[REG_STAT_2];
+
+    const uint16_t ocv = (uint16_t)(_ocv_mV + 0.5);
+    const bool vinOvp = (_vin_mV >= VIN_OVP_MV);
+    const bool vinGood = (_vin_mV >= VIN_UVLO_MV) && (_vin_mV > ocv + VIN_SLEEP_MV) && !vinOvp;
+
+    // TS regions: higher voltage is colder (NTC to ground).
+    const bool tsEnabled = (_regs[REG_CHARGERCTRL0] & TS_EN_MASK) != 0;
+    const bool tsOpen = (_ts_mV > TS_OPEN_MV);
+    const bool tsCold = tsEnabled && (_ts_mV > _regs[REG_TS_COLD] * TS_TH_MV);
+    const bool tsHot = tsEnabled && (_ts_mV < _regs[REG_TS_HOT] * TS_TH_MV);
+    const bool tsCool = tsEnabled && !tsCold && (_ts_mV > _regs[REG_TS_COOL] * TS_TH_MV);
+    const bool tsWarm = tsEnabled && !tsHot && (_ts_mV < _regs[REG_TS_WARM] * TS_TH_MV);
+
+    const bool disabled = _ceHigh || (_regs[REG_ICCTRL2] & CHARGER_DISABLE_MASK) != 0;
+    const bool suspended = tsCold || tsHot || (tsEnabled && tsOpen) || _forceOCP;
+
+    uint16_t vreg = regulationVoltage_mV();
+    if (tsWarm) {
+        const uint16_t drop = ((_regs[REG_TS_FASTCHGCTRL] & TS_VBAT_REG_MASK) >> 4) * 50;
+        vreg = (vreg > drop) ? (uint16_t)(vreg - drop) : 0;
+    }
+
+    bool iinlimActive = false;
+    _ichg_uA = 0;
+
+    if (!vinGood || disabled) {
+        _phase = vinGood ? ChargePhase::DISABLED : ChargePhase::NO_INPUT;
+        _chargeStartUs = _nowUs;
+        _timerExpired = false;
+    } else if (_timerExpired) {
+        _phase = ChargePhase::TIMER_FAULT;
+    } else if (suspended) {
+        _phase = ChargePhase::SUSPENDED;
+    } else {
+        if (_phase == ChargePhase::DONE) {
+            // Recharge once the battery relaxes below VREG - VRH (model: 100 mV / 200 mV).
+            const uint16_t vrh = (_regs[REG_CHARGERCTRL0] & VRH_THRESH_MASK) ? 200 : 100;
+            if (ocv + vrh < vreg) {
+                _phase = ChargePhase::FASTCHARGE;
+                _chargeStartUs = _nowUs;
+            }
+        } else if (_phase != ChargePhase::PRECHARGE && _phase != ChargePhase::FASTCHARGE &&
+                   _phase != ChargePhase::TAPER) {
+            _chargeStartUs = _nowUs; // Entering charge: safety timer starts
+        }
+
+        if (_phase != ChargePhase::DONE) {
+            const uint16_t vlowv = (_regs[REG_BUVLO] & VLOWV_SEL_MASK) ? 2800 : 3000;
+            const bool pre = (ocv < vlowv);
+            uint32_t target = pre ? prechargeCurrent_uA() : fastChargeCurrent_uA();
+            if (tsCool) {
+                target = target * TS_ICHRG_PERMILLE[_regs[REG_TS_FASTCHGCTRL] & TS_ICHRG_MASK] / 1000UL;
+            }
+            _ichgRef_uA = target;
+
+            // CV: terminal voltage may not exceed VREG.
+            bool cv = false;
+            const double headroom_mV = (double)vreg - _ocv_mV;
+            if (headroom_mV <= 0.0) {
+                target = 0;
+                cv = true;
+            } else if (_rbat_mOhm != 0) {
+                const double maxCv_uA = headroom_mV * 1e6 / (double)_rbat_mOhm;
+                if ((double)target >= maxCv_uA) {
+                    target = (uint32_t)maxCv_uA;
+                    cv = true;
+                }
+            }
+
+            // Input current limit: power balance VIN * IIN = VBAT * ICHG + system load.
+            const uint32_t ilim = inputLimit_uA();
+            const uint32_t load = (_sysLoad_uA < ilim) ? _sysLoad_uA : ilim;
+            const uint32_t chgIn = (uint32_t)((uint64_t)target * ocv / _vin_mV);
+            if (load + chgIn > ilim) {
+                iinlimActive = true;
+                target = (uint32_t)((uint64_t)(ilim - load) * _vin_mV / (ocv ? ocv : 1));
+                cv = false;
+            }
+
+            _ichg_uA = target;
+            _phase = cv ? ChargePhase::TAPER : (pre ? ChargePhase::PRECHARGE : ChargePhase::FASTCHARGE);
+
+            // Termination (disabled by TERM_DISABLE)
+            const uint32_t iterm = fastChargeCurrent_uA() * ((_regs[REG_TERMCTRL] & ITERM_MASK) >> 1) / 100UL;
+            if (cv && (_regs[REG_TERMCTRL] & TERM_DISABLE_MASK) == 0 && _ichg_uA <= iterm) {
+                _phase = ChargePhase::DONE;
+                _ichg_uA = 0;
+            }
+        }
+
+        // Safety timer
+        const uint32_t limit_s = SAFETY_TIMER_S[(_regs[REG_CHARGERCTRL0] & SAFETY_TIMER_LIMIT_MASK) >> 1];
+        if (limit_s != 0 && _phase != ChargePhase::DONE &&
+            (_nowUs - _chargeStartUs) >= (uint64_t)limit_s * 1000000ULL) {
+            _timerExpired = true;
+            _phase = ChargePhase::TIMER_FAULT;
+            _ichg_uA = 0;
+            setFlags(REG_FLAG_3, SAFETY_TMR_FAULT_FLAG_MASK);
+        }
+    }
+
+    _vbatTerm_mV = (uint16_t)(_ocv_mV + (double)_ichg_uA * _rbat_mOhm / 1e6 + 0.5);
+    _iin_uA = vinGood ? (uint32_t)(_sysLoad_uA + (uint64_t)_ichg_uA * _vbatTerm_mV / _vin_mV) : 0;
+
+    uint8_t stat0 = 0;
+    if (vinGood) { stat0 |= VIN_PGOOD_STAT_MASK; }
+    if (iinlimActive) { stat0 |= IINLIM_ACTIVE_STAT_MASK; }
+    if (_phase == ChargePhase::TAPER) { stat0 |= CHRG_CV_STAT_MASK; }
+    if (_phase == ChargePhase::DONE) { stat0 |= CHARGE_DONE_STAT_MASK; }
+
+    uint8_t stat1 = 0;
+    if (vinOvp) { stat1 |= VIN_OVP_FAULT_STAT_MASK; }
+    if (_forceOCP) { stat1 |= BAT_OCP_FAULT_STAT_MASK; }
+    const uint16_t buvlo = BUVLO_TABLE_MV[_regs[REG_BUVLO] & BUVLO_MASK];
+    if (buvlo != 0 && _vbatTerm_mV < buvlo) { stat1 |= BAT_UVLO_FAULT_STAT_MASK; }
+    if (tsCold) { stat1 |= TS_COLD_STAT_MASK; }
+    if (tsCool) { stat1 |= TS_COOL_STAT_MASK; }
+    if (tsWarm) { stat1 |= TS_WARM_STAT_MASK; }
+    if (tsHot) { stat1 |= TS_HOT_STAT_MASK; }
+
+    // Comparator status bits are owned by evaluateComparators().
+    uint8_t stat2 = (uint8_t)(old2 & (COMP1_ALARM_STAT_MASK | COMP2_ALARM_STAT_MASK | COMP3_ALARM_STAT_MASK));
+    if (tsOpen) { stat2 |= TS_OPEN_STAT_MASK; }
+
+    _regs[REG_STAT_0] = stat0;
+    _regs[REG_STAT_1] = stat1;
+    _regs[REG_STAT_2] = stat2;
+
+    // Flags latch on entry into a state; VIN_PGOOD latches on both edges.
+    setFlags(REG_FLAG_0, (uint8_t)((stat0 & ~old0) | ((stat0 ^ old0) & VIN_PGOOD_FLAG_MASK)));
+    setFlags(REG_FLAG_1, (uint8_t)(stat1 & ~old1));
+    setFlags(REG_FLAG_2, (uint8_t)((stat2 & ~old2) & TS_OPEN_FLAG_MASK));
+}
+
+void Bq25155Sim::setFlags(uint8_t flagReg, uint8_t bits) {
+    _regs[flagReg] |= bits;
+}
+
+// --- ADC ---
+
+uint32_t Bq25155Sim::adcConversionUs() const {
+    static constexpr uint32_t CONV_US[4] = {24000, 12000, 6000, 3000};
+    return CONV_US[(_regs[REG_ADCCTRL0] & ADC_CONV_SPEED_MASK) >> 3];
+}
+
+uint64_t Bq25155Sim::adcPeriodUs() const {
+    switch ((_regs[REG_ADCCTRL0] & ADC_READ_RATE_MASK) >> 6) {
+        case ADC_READ_RATE_CNTNS: return 1; // Next sweep starts as soon as one finishes
+        case ADC_READ_RATE_1S:    return 1000000ULL;
+        case ADC_READ_RATE_1M:    return 60000000ULL;
+        default:                  return 0; // Manual: only ADC_CONV_START
+    }
+}
+
+void Bq25155Sim::startAdcSweep() {
+    // One conversion slot per enabled channel (comparator channels included).
+    uint8_t channels = _regs[REG_ADC_READ_EN] & VALID_ADC_MASKS;
+    channels |= COMP_CHANNEL_EN[_regs[REG_ADCCTRL0] & ADC_COMP1_MASK];
+    channels |= COMP_CHANNEL_EN[(_regs[REG_ADCCTRL1] & ADC_COMP2_MASK) >> 5];
+    channels |= COMP_CHANNEL_EN[(_regs[REG_ADCCTRL1] & ADC_COMP3_MASK) >> 2];
+    uint8_t count = 0;
+    for (uint8_t b = channels; b != 0; b &= (uint8_t)(b - 1)) { count++; }
+    if (count == 0) { count = 1; }
+
+    _adcBusy = true;
+    _adcDoneUs = _nowUs + (uint64_t)count * adcConversionUs();
+    _regs[REG_ADCCTRL0] |= ADC_CONV_START_MASK;
+}
+
+uint16_t Bq25155Sim::adcCode(uint8_t compChannel) const {
+    uint32_t code = 0;
+    switch (compChannel) {
+        case ADC_COMPx_ADCIN: code = (uint32_t)_adcin_mV * 65536UL / 1200UL; break;
+        case ADC_COMPx_TS:    code = (uint32_t)_ts_mV * 65536UL / 1200UL; break;
+        case ADC_COMPx_VBAT:  code = (uint32_t)_vbatTerm_mV * 65536UL / 6000UL; break;
+        case ADC_COMPx_VIN:   code = (uint32_t)_vin_mV * 65536UL / 6000UL; break;
+        case ADC_COMPx_PMID: {
+            const bool vinGood = (_regs[REG_STAT_0] & VIN_PGOOD_STAT_MASK) != 0;
+            const uint32_t pmid = vinGood ? (uint32_t)(_vin_mV - PMID_DROP_MV) : _vbatTerm_mV;
+            code = pmid * 65536UL / 6000UL;
+            break;
+        }
+        case ADC_COMPx_ICHG:
+            // Full scale 0.8 x 65536 = 100 % of the active ICHARGE setting
+            code = (_ichgRef_uA == 0) ? 0 : (uint32_t)((uint64_t)_ichg_uA * 52429ULL / _ichgRef_uA);
+            break;
+        case ADC_COMPx_IIN: {
+            const uint32_t scale = ((_regs[REG_ILIMCTRL] & ILIM_MASK) > 2) ? 750000UL : 375000UL;
+            code = (uint32_t)((uint64_t)_iin_uA * 65536ULL / scale);
+            break;
+        }
+        default: break;
+    }
+    if (code > 0xFFFF) { code = 0xFFFF; }
+    const uint8_t speed = (_regs[REG_ADCCTRL0] & ADC_CONV_SPEED_MASK) >> 3;
+    return (uint16_t)(code & ((speed >= ADC_CONV_SPEED_6MS) ? 0xFFC0 : 0xFFF0));
+}
+
+void Bq25155Sim::finishAdcSweep() {
+    const uint8_t enabled = _regs[REG_ADC_READ_EN];
+    for (uint8_t ch = ADC_COMPx_ADCIN; ch <= ADC_COMPx_IIN; ch++) {
+        if ((enabled & COMP_CHANNEL_EN[ch]) == 0) { continue; }
+        const uint16_t code = adcCode(ch);
+        _regs[COMP_CHANNEL_REG[ch]] = (uint8_t)(code >> 8);
+        _regs[COMP_CHANNEL_REG[ch] + 1] = (uint8_t)(code & 0xFF);
+    }
+    _adcBusy = false;
+    _adcSweeps++;
+    _regs[REG_ADCCTRL0] &= (uint8_t)~ADC_CONV_START_MASK; // Self-clears when done
+    setFlags(REG_FLAG_2, ADC_READY_FLAG_MASK);
+    evaluateComparators();
+}
+
+void Bq25155Sim::evaluateComparators() {
+    const uint8_t compChannel[3] = {
+        (uint8_t)(_regs[REG_ADCCTRL0] & ADC_COMP1_MASK),
+        (uint8_t)((_regs[REG_ADCCTRL1] & ADC_COMP2_MASK) >> 5),
+        (uint8_t)((_regs[REG_ADCCTRL1] & ADC_COMP3_MASK) >> 2)
+    };
+
+    for (uint8_t i = 0; i < 3; i++) {
+        bool alarm = false;
+        if (compChannel[i] != ADC_COMPx_DIS) {
+            const uint8_t msb = _regs[REG_ADCALARM_COMP1_M + 2 * i];
+            const uint8_t lsb = _regs[REG_ADCALARM_COMP1_L + 2 * i];
+            const uint16_t threshold = (uint16_t)((msb << 4) | ((lsb & ADCALARM_LSB) >> 4));
+            const uint16_t value = adcCode(compChannel[i]) >> 4; // 12-bit compare
+            alarm = (lsb & ADCALARM_POL) ? (value > threshold) : (value < threshold);
+        }
+
+        const uint8_t mask = COMP_STAT_MASK[i];
+        const bool wasAlarm = (_regs[REG_STAT_2] & mask) != 0;
+        if (alarm) {
+            _regs[REG_STAT_2] |= mask;
+            if (!wasAlarm) { setFlags(REG_FLAG_2, mask); }
+        } else {
+            _regs[REG_STAT_2] &= (uint8_t)~mask;
+        }
+    }
+}
+
+// --- SimBus ---
+
+SimBus::SimBus(Bq25155Sim *sim, uint32_t clockHz)
+    : _sim(sim), _clockHz(clockHz), _carryNs(0), _faultFirst(1), _faultLast(0) {
+    resetCounters();
+}
+
+void SimBus::setWriteFault(uint8_t firstReg, uint8_t lastReg) {
+    _faultFirst = firstReg;
+    _faultLast = lastReg;
+}
+
+void SimBus::resetCounters() {
+    _counters.transactions = 0;
+    _counters.writeTransactions = 0;
+    _counters.readTransactions = 0;
+    _counters.bytes = 0;
+    _counters.nacks = 0;
+    _counters.bits = 0;
+}
+
+bool SimBus::begin() {
+    return (_sim != nullptr);
+}
+
+bool SimBus::probe(uint8_t addr) {
+    const bool ack = (_sim != nullptr) && (addr == bq25155_ADDR) && _sim->i2cAvailable();
+    account(false, 1, ack);
+    return ack;
+}
+
+bool SimBus::write(uint8_t addr, uint8_t reg, const uint8_t *data, uint8_t len) {
+    const bool faulted = (len != 0) && reg <= _faultLast && (uint16_t)(reg + len - 1) >= _faultFirst;
+    const bool ack = (_sim != nullptr) && (addr == bq25155_ADDR) && !faulted && _sim->write(reg, data, len);
+    account(false, 2UL + len, ack);
+    return ack;
+}
+
+bool SimBus::read(uint8_t addr, uint8_t reg, uint8_t *buf, uint8_t len) {
+    const bool ack = (_sim != nullptr) && (addr == bq25155_ADDR) && _sim->read(reg, buf, len);
+    account(true, 3UL + len, ack);
+    return ack;
+}
+
+void SimBus::account(bool isRead, uint32_t bytesOnWire, bool ack) {
+    // START + 9 clocks per byte + STOP, plus a repeated START for reads.
+    const uint32_t bits = 2UL + 9UL * bytesOnWire + (isRead ? 1UL : 0UL);
+    _counters.transactions++;
+    if (isRead) { _counters.readTransactions++; } else { _counters.writeTransactions++; }
+    _counters.bytes += bytesOnWire;
+    _counters.bits += bits;
+    if (!ack) { _counters.nacks++; }
+
+    if (_sim != nullptr && _clockHz != 0) {
+        const uint64_t ns = (uint64_t)bits * 1000000000ULL / _clockHz + _carryNs;
+        _carryNs = (uint32_t)(ns % 1000ULL);
+        _sim->advance((uint32_t)(ns / 1000ULL));
+    }
+}
+
+} // namespace bq25155_sim
@@ -0,0 +1,141 @@
+/*
+ * @brief         Host-side register-level simulator of the bq25155
+ * @note          Models what the driver can observe over I2C: clear-on-read FLAG0-3,
+ *                STAT0-2 from a simple charger state machine, ADC sweeps paced by
+ *                ADCCTRL0 (rate, speed, CONV_START self-clear), the three ADC
+ *                comparators, INT assertion through MASK0-3 and DEVICE_ID 0x35.
+ *                Analog thresholds (UVLO, OVP, TS open, battery model) are model values,
+ *                not datasheet limits. Thermal regulation, VINDPM/DPPM and the I2C
+ *                watchdog are not modeled.
+ * @version       1.1.4
+ * @creation date 2026-03-09
+ * @updated date  2026-03-09
+ * @author        jul10199555
+ *
+ * Repo:
+ * https://github.com/jul10199555/bq25155-Arduino-Library
+ *
+ */
+
+#ifndef BQ25155_SIM_H
+#define BQ25155_SIM_H
+
+#include "bq25155.h"
+#include "bq25155_sim_bus.h"
+
+namespace bq25155_sim {
+
+// Model thresholds (mV / uA)
+static constexpr uint16_t VIN_UVLO_MV = 3150;     // VIN below this: no input
+static constexpr uint16_t VIN_SLEEP_MV = 50;      // VIN must exceed VBAT by this
+static constexpr uint16_t VIN_OVP_MV = 5700;      // VIN at/above this: OVP fault
+static constexpr uint16_t TS_OPEN_MV = 1100;      // VTS above this: thermistor open
+static constexpr uint16_t PMID_DROP_MV = 50;      // PMID = VIN - drop while VIN is good
+static constexpr uint16_t CV_ENTRY_MV = 10;       // terminal within this of VREG: CV status
+
+enum class ChargePhase : uint8_t {
+    NO_INPUT = 0,   // VIN not good
+    DISABLED,       // /CE high or CHARGER_DISABLE set
+    SUSPENDED,      // TS hot/cold, TS open or BAT OCP
+    PRECHARGE,      // VBAT < VLOWV
+    FASTCHARGE,     // constant current
+    TAPER,          // constant voltage
+    DONE,           // termination reached
+    TIMER_FAULT     // safety timer expired
+};
+
+class Bq25155Sim {
+public:
+    Bq25155Sim();
+
+    // Registers back to their defaults, flags cleared, charge timer restarted.
+    // Analog inputs and the simulated clock are kept.
+    void registerReset();
+
+    // --- Analog and pin side ---
+    void setVIN(uint16_t mV);
+    void setBatteryOCV(uint16_t mV);            // open-circuit battery voltage
+    void setBatteryCapacity(uint16_t mAh);      // 0: OCV stays fixed while charging
+    void setBatteryResistance(uint16_t mOhm);   // terminal = OCV + I * R
+    void setTS(uint16_t mV);
+    void setADCIN(uint16_t mV);
+    void setSystemLoad(uint32_t uA);            // PMID load drawn from VIN when present
+    void setCEPin(bool high);                   // /CE: LOW enables charge
+    void setLPMPin(bool high);                  // LPM: HIGH keeps I2C alive on battery
+    void setBatteryOCP(bool active);            // force BAT_OCP_FAULT
+
+    bool intAsserted() const;                   // true while /INT is pulled low
+    bool i2cAvailable() const;                  // VIN good or LPM high
+
+    // --- Time ---
+    void advance(uint32_t us);
+    uint64_t nowUs() const { return _nowUs; }
+
+    // --- Register side (each call is one I2C transaction, auto-increment address) ---
+    bool write(uint8_t reg, const uint8_t *data, uint8_t len);
+    bool read(uint8_t reg, uint8_t *buf, uint8_t len);
+    uint8_t peek(uint8_t reg) const { return _regs[reg]; } // no side effects
+    void poke(uint8_t reg, uint8_t value);                  // no side effects except status refresh
+
+    // --- Observed model state ---
+    ChargePhase phase() const { return _phase; }
+    uint32_t chargeCurrent_uA() const { return _ichg_uA; }
+    uint32_t inputCurrent_uA() const { return _iin_uA; }
+    uint16_t vbat_mV() const { return _vbatTerm_mV; }
+    uint32_t adcSweeps() const { return _adcSweeps; }
+    uint32_t registerWrites() const { return _regWrites; }
+    bool cePinHigh() const { return _ceHigh; }
+
+private:
+    void resetRegisters();
+    void applyWrite(uint8_t reg, uint8_t value);
+    void updateStatus();
+    void integrateBattery(uint32_t us);
+    void startAdcSweep();
+    void finishAdcSweep();
+    void evaluateComparators();
+    uint64_t adcPeriodUs() const;
+    uint32_t adcConversionUs() const;
+    uint16_t adcCode(uint8_t compChannel) const;
+    void setFlags(uint8_t flagReg, uint8_t bits);
+
+    uint32_t fastChargeCurrent_uA() const;
+    uint32_t prechargeCurrent_uA() const;
+    uint32_t inputLimit_uA() const;
+    uint16_t regulationVoltage_mV() const;
+
+    uint8_t _regs[256];
+    uint64_t _nowUs;
+
+    // Analog inputs
+    uint16_t _vin_mV;
+    double _ocv_mV;
+    uint16_t _capacity_mAh;
+    uint16_t _rbat_mOhm;
+    uint16_t _ts_mV;
+    uint16_t _adcin_mV;
+    uint32_t _sysLoad_uA;
+    bool _ceHigh;
+    bool _lpmHigh;
+    bool _forceOCP;
+
+    // Charger state
+    ChargePhase _phase;
+    uint32_t _ichg_uA;
+    uint32_t _iin_uA;
+    uint32_t _ichgRef_uA;  // ICHARGE the ICHG ADC channel is relative to
+    uint16_t _vbatTerm_mV;
+    uint64_t _chargeStartUs;
+    bool _timerExpired;
+
+    // ADC state
+    bool _adcBusy;
+    uint64_t _adcDoneUs;
+    uint64_t _adcNextUs;
+    uint32_t _adcSweeps;
+    uint32_t _regWrites;
+};
+
+} // namespace bq25155_sim
+
+#endif // BQ25155_SIM_H
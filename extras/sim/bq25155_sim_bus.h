@@ -0,0 +1,79 @@
+/*
+ * @brief         Simulated I2C transport for bq25155's Arduino library
+ * @note          Transport stand-in that forwards register I/O to a Bq25155Sim and
+ *                accounts for every transaction, byte and bus bit.
+ *                Select it for the driver with:
+ *                -DBQ25155_TRANSPORT_HEADER='"bq25155_sim_bus.h"'
+ *                -DBQ25155_TRANSPORT=bq25155_sim::SimBus
+ * @version       1.1.4
+ * @creation date 2026-03-09
+ * @updated date  2026-03-09
+ * @author        jul10199555
+ *
+ * Repo:
+ * https://github.com/jul10199555/bq25155-Arduino-Library
+ *
+ */
+
+#ifndef BQ25155_SIM_BUS_H
+#define BQ25155_SIM_BUS_H
+
+#include "bq25155_port.h"
+
+namespace bq25155_sim {
+
+class Bq25155Sim;
+
+// Bus counters. Bits follow the I2C framing: START, 9 clocks per byte (8 + ACK), a repeated
+// START before the read phase and a STOP, so bits / clock_Hz is the wire time.
+struct BusCounters {
+    uint32_t transactions;
+    uint32_t writeTransactions;
+    uint32_t readTransactions;
+    uint32_t bytes;       // address + register + data bytes on the wire
+    uint32_t nacks;
+    uint64_t bits;
+
+    // Wire time at a given SCL rate, rounded up to whole microseconds.
+    uint64_t busTimeUs(uint32_t clockHz) const {
+        return (clockHz == 0) ? 0 : (bits * 1000000ULL + clockHz - 1) / clockHz;
+    }
+};
+
+class SimBus {
+public:
+    // clockHz also advances the simulator clock by the wire time of each transaction
+    // (0 keeps simulated time still during bus traffic).
+    SimBus(Bq25155Sim *sim = nullptr, uint32_t clockHz = 400000);
+
+    void attach(Bq25155Sim *sim) { _sim = sim; }
+    Bq25155Sim *sim() const { return _sim; }
+    void setClockHz(uint32_t clockHz) { _clockHz = clockHz; }
+    uint32_t clockHz() const { return _clockHz; }
+
+    bool begin();
+    bool probe(uint8_t addr);
+    bool write(uint8_t addr, uint8_t reg, const uint8_t *data, uint8_t len);
+    bool read(uint8_t addr, uint8_t reg, uint8_t *buf, uint8_t len);
+
+    const BusCounters &counters() const { return _counters; }
+    void resetCounters();
+
+    // Fault injection: writes touching firstReg..lastReg are NACKed and never reach the device.
+    void setWriteFault(uint8_t firstReg, uint8_t lastReg);
+    void clearWriteFault() { _faultFirst = 1; _faultLast = 0; }
+
+private:
+    void account(bool isRead, uint32_t bytesOnWire, bool ack);
+
+    Bq25155Sim *_sim;
+    uint32_t _clockHz;
+    uint32_t _carryNs; // sub-microsecond wire time not yet passed to the simulator
+    uint8_t _faultFirst; // empty range (first > last): no fault
+    uint8_t _faultLast;
+    BusCounters _counters;
+};
+
+} // namespace bq25155_sim
+
+#endif // BQ25155_SIM_BUS_H
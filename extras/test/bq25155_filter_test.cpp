@@ -0,0 +1,226 @@
+/*
+ * @brief         Host test of the bq25155 streaming filters (bq25155_filter.h)
+ * @note          Step and spike responses of MovingAverage, Ema, Median and WindowStats,
+ *                median-of-5 against a sort for every input over a 5-value alphabet, and
+ *                full-scale (0xFFFF) input through the widest windows to catch accumulator
+ *                overflow. Built with Arduino-style min()/max() macros defined.
+ *
+ *                Build and run from the repository root:
+ *                  g++ -std=gnu++11 -O2 -Isrc extras/test/bq25155_filter_test.cpp \
+ *                      -o bq25155_filter_test
+ *                  ./bq25155_filter_test
+ *
+ *                Exits with status 1 on the first failed check.
+ * @version       1.1.4
+ * @creation date 2026-03-09
+ * @updated date  2026-03-09
+ * @author        jul10199555
+ *
+ * Repo:
+ * https://github.com/jul10199555/bq25155-Arduino-Library
+ *
+ */
+
+// The Arduino core defines these as macros; the filters must not collide with them.
+#define min(a, b) ((a) < (b) ? (a) : (b))
+#define max(a, b) ((a) > (b) ? (a) : (b))
+
+#include "bq25155_filter.h"
+
+#include <cstdio>
+
+using namespace bq25155_filter;
+
+static int failures = 0;
+
+#define CHECK(cond)                                                              \
+    do {                                                                         \
+        if (!(cond)) {                                                           \
+            std::printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);          \
+            failures++;                                                          \
+        }                                                                        \
+    } while (0)
+
+template <typename Filter, int N>
+static bool outputs(Filter &filter, const uint16_t (&in)[N], const uint16_t (&expected)[N]) {
+    bool same = true;
+    for (int i = 0; i < N; i++) {
+        const uint16_t out = filter.update(in[i]);
+        if (out != expected[i] || filter.value() != expected[i]) {
+            std::printf("  sample %d: in %u out %u expected %u\n", i, in[i], out, expected[i]);
+            same = false;
+        }
+    }
+    return same;
+}
+
+static void testMovingAverage() {
+    MovingAverage<2> ma;
+    const uint16_t step[] = { 100, 500, 500, 500, 500, 500 };
+    const uint16_t want[] = { 100, 200, 300, 400, 500, 500 };
+    CHECK(!ma.ready());
+    CHECK(outputs(ma, step, want));
+    CHECK(ma.ready());
+
+    ma.reset();
+    CHECK(!ma.ready());
+    CHECK(ma.update(42) == 42); // First sample after reset fills the history
+}
+
+static void testEma() {
+    Ema<3> ema;
+    CHECK(ema.update(0) == 0);
+    uint16_t last = 0;
+    bool monotonic = true;
+    int settled = -1;
+    for (int i = 1; i <= 200; i++) {
+        const uint16_t out = ema.update(800);
+        if (out < last) { monotonic = false; }
+        if (settled < 0 && out >= 792) { settled = i; } // Within 1%
+        last = out;
+    }
+    CHECK(monotonic);
+    CHECK(last == 800); // No rounding offset once settled
+    CHECK(settled > 0 && settled <= 40); // About 4.6 x 2^3 samples
+    CHECK(ema.ready());
+
+    ema.reset();
+    CHECK(!ema.ready());
+    CHECK(ema.update(123) == 123);
+}
+
+static void testMedian() {
+    Median<3> m3;
+    const uint16_t spike[] = { 100, 100, 900, 100, 100 };
+    const uint16_t flat[] = { 100, 100, 100, 100, 100 };
+    CHECK(outputs(m3, spike, flat));
+
+    Median<3> edge;
+    const uint16_t step[] = { 100, 100, 500, 500, 500 };
+    const uint16_t delayed[] = { 100, 100, 100, 500, 500 };
+    CHECK(outputs(edge, step, delayed));
+
+    Median<5> m5;
+    const uint16_t doubleSpike[] = { 100, 100, 900, 900, 100, 100 };
+    const uint16_t flat6[] = { 100, 100, 100, 100, 100, 100 };
+    CHECK(outputs(m5, doubleSpike, flat6));
+
+    // Every 5-sample input over {0..4}: the network must agree with a sort.
+    int bad = 0;
+    for (int code = 0; code < 5 * 5 * 5 * 5 * 5; code++) {
+        uint16_t in[5];
+        int rest = code;
+        for (int i = 0; i < 5; i++) {
+            in[i] = (uint16_t)(rest % 5);
+            rest /= 5;
+        }
+        Median<5> m;
+        uint16_t out = 0;
+        for (int i = 0; i < 5; i++) { out = m.update(in[i]); }
+
+        uint16_t sorted[5];
+        for (int i = 0; i < 5; i++) { sorted[i] = in[i]; }
+        for (int i = 0; i < 5; i++) {
+            for (int j = i + 1; j < 5; j++) {
+                if (sorted[j] < sorted[i]) {
+                    const uint16_t t = sorted[i];
+                    sorted[i] = sorted[j];
+                    sorted[j] = t;
+                }
+            }
+        }
+        if (out != sorted[2]) { bad++; }
+    }
+    CHECK(bad == 0);
+}
+
+static void testWindowStats() {
+    WindowStats<2> w;
+    const uint16_t in[] = { 3, 9, 1, 5 };
+    for (int i = 0; i < 4; i++) {
+        CHECK(!w.windowClosed());
+        w.update(in[i]);
+    }
+    CHECK(w.windowClosed());
+    CHECK(w.ready());
+    CHECK(w.windows() == 1);
+    CHECK(w.minimum() == 1);
+    CHECK(w.maximum() == 9);
+    CHECK(w.mean() == 4);
+
+    // The published triple holds until the next window closes.
+    w.update(1000);
+    CHECK(!w.windowClosed());
+    CHECK(w.maximum() == 9);
+    w.update(1000);
+    w.update(1000);
+    w.update(1000);
+    CHECK(w.windowClosed());
+    CHECK(w.windows() == 2);
+    CHECK(w.minimum() == 1000 && w.maximum() == 1000 && w.mean() == 1000);
+}
+
+static void testFullScale() {
+    MovingAverage<7> ma;
+    Ema<15> ema;
+    WindowStats<15> w;
+    bool ok = true;
+    for (uint32_t i = 0; i < WindowStats<15>::WINDOW; i++) {
+        if (ma.update(0xFFFF) != 0xFFFF) { ok = false; }
+        if (ema.update(0xFFFF) != 0xFFFF) { ok = false; }
+        w.update(0xFFFF);
+    }
+    CHECK(ok);
+    CHECK(w.windowClosed());
+    CHECK(w.mean() == 0xFFFF && w.minimum() == 0xFFFF && w.maximum() == 0xFFFF);
+
+    // Step from zero to full scale with the slowest EMA: rises without wrapping.
+    Ema<15> rise;
+    rise.update(0);
+    uint16_t last = 0;
+    bool monotonic = true;
+    for (uint32_t i = 0; i < 400000UL; i++) {
+        const uint16_t out = rise.update(0xFFFF);
+        if (out < last) { monotonic = false; }
+        last = out;
+    }
+    CHECK(monotonic);
+    CHECK(last == 0xFFFF);
+}
+
+struct Frame {
+    uint16_t raw[7];
+};
+
+static void testChannelBank() {
+    ChannelFilterBank<MovingAverage<1>, 7> bank;
+    Frame a = { { 10, 20, 30, 40, 50, 60, 70 } };
+    Frame b = { { 30, 40, 50, 60, 70, 80, 90 } };
+    bank.updateFrame(a);
+    CHECK(!bank.ready());
+    bank.updateFrame(b);
+    CHECK(bank.ready());
+
+    uint16_t out[7];
+    bank.values(out);
+    for (uint8_t ch = 0; ch < 7; ch++) { CHECK(out[ch] == (uint16_t)(20 + 10 * ch)); }
+    CHECK(bank.value(6) == 80);
+
+    bank.reset();
+    CHECK(!bank.ready());
+}
+
+int main() {
+    testMovingAverage();
+    testEma();
+    testMedian();
+    testWindowStats();
+    testFullScale();
+    testChannelBank();
+    if (failures != 0) {
+        std::printf("%d check(s) failed\n", failures);
+        return 1;
+    }
+    std::printf("filter: all checks passed\n");
+    return 0;
+}
@@ -0,0 +1,199 @@
+/*
+ * @brief         Host test of the bq25155 charge-profile image against the setter chain
+ * @note          Drives two simulated devices with the same 400 random profiles: one through
+ *                applyChargeProfile() (compiled register image), the other through the
+ *                individual setters it replaces. VBAT_CTRL..ILIMCTRL and ICCTRL2 must match
+ *                after every profile, and the profile bits must equal
+ *                bq25155_const::compileChargeProfile(). A NACKed image write must return
+ *                false and leave charge off.
+ *
+ *                Build and run from the repository root:
+ *                  g++ -std=gnu++11 -O2 -Isrc -Iextras/sim \
+ *                      -DBQ25155_TRANSPORT_HEADER='"bq25155_sim_bus.h"' \
+ *                      -DBQ25155_TRANSPORT=bq25155_sim::SimBus \
+ *                      extras/test/bq25155_profile_test.cpp src/bq25155.cpp src/bq25155_port.cpp \
+ *                      extras/sim/bq25155_sim.cpp -o bq25155_profile_test
+ *                  ./bq25155_profile_test
+ *
+ *                Exits with status 1 when any profile differs.
+ * @version       1.1.4
+ * @creation date 2026-03-09
+ * @updated date  2026-03-09
+ * @author        jul10199555
+ *
+ * Repo:
+ * https://github.com/jul10199555/bq25155-Arduino-Library
+ *
+ */
+
+#include "bq25155_sim.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+using namespace bq25155_sim;
+
+// Device A: applyChargeProfile(). Device B: setter chain.
+static constexpr uint8_t PIN_CHEN_A = 2;
+static constexpr uint8_t PIN_INT_A = 5;
+static constexpr uint8_t PIN_LPM_A = 20;
+static constexpr uint8_t PIN_CHEN_B = 3;
+static constexpr uint8_t PIN_INT_B = 6;
+static constexpr uint8_t PIN_LPM_B = 21;
+
+static constexpr BatteryChemistry CHEMISTRY = BatteryChemistry::LI_HV_4V35;
+static constexpr int PROFILES = 400;
+
+static Bq25155Sim simA;
+static Bq25155Sim simB;
+
+// A profile the setters accept unchanged must compile to the same image at build time.
+using Reference = StaticChargeProfile<4200, true, 100000, 20000, ILIMLevel::ILIM_200mA>;
+static_assert(Reference::image().regs[0] == 60, "VBATREG code for 4.2 V");
+static_assert(Reference::image().regs[1] == 40, "ICHG code for 100 mA in fast-charge range");
+static_assert(Reference::image().regs[2] == (bq25155_const::ICHARGE_RANGE_MASK | 8), "IPRECHG code for 20 mA");
+
+namespace bq25155_port {
+void pinMode(uint8_t, uint8_t) {}
+void digitalWrite(uint8_t pin, uint8_t value) {
+    if (pin == PIN_CHEN_A) { simA.setCEPin(value != LOW); }
+    if (pin == PIN_LPM_A) { simA.setLPMPin(value != LOW); }
+    if (pin == PIN_CHEN_B) { simB.setCEPin(value != LOW); }
+    if (pin == PIN_LPM_B) { simB.setLPMPin(value != LOW); }
+}
+int digitalRead(uint8_t pin) {
+    if (pin == PIN_INT_A) { return simA.intAsserted() ? LOW : HIGH; }
+    if (pin == PIN_INT_B) { return simB.intAsserted() ? LOW : HIGH; }
+    return HIGH;
+}
+unsigned long millis() { return (unsigned long)(simA.nowUs() / 1000); }
+unsigned long micros() { return (unsigned long)simA.nowUs(); }
+void delay(unsigned long ms) {
+    simA.advance((uint64_t)ms * 1000);
+    simB.advance((uint64_t)ms * 1000);
+}
+} // namespace bq25155_port
+
+// applyChargeProfile() as it was before the register image: one setter per field.
+static bool applyWithSetters(bq25155 &charger, const ChargeProfile &profile) {
+    if (!charger.setChargeVoltage(profile.chargeVoltage_mV)) { return false; }
+    if (!(profile.enableFastCharge ? charger.EnableFastCharge() : charger.DisableFastCharge())) { return false; }
+    if (!charger.setILIM(profile.inputCurrentLimit)) { return false; }
+    if (!charger.setChargeCurrent(profile.chargeCurrent_uA)) { return false; }
+    if (!charger.setPreChargeCurrent(profile.prechargeCurrent_uA)) { return false; }
+    if (!charger.setChgSafetyTimer(profile.safetyTimer)) { return false; }
+    if (!(profile.use2xSafetyTimer ? charger.set2xSafetyTimer() : charger.set1xSafetyTimer())) { return false; }
+    return charger.EnableCharge();
+}
+
+static void dump(const char *label, Bq25155Sim &sim) {
+    std::printf("  %s:", label);
+    for (uint8_t reg = bq25155_const::CHARGE_IMAGE_FIRST;
+         reg < bq25155_const::CHARGE_IMAGE_FIRST + bq25155_const::CHARGE_IMAGE_LEN; reg++) {
+        std::printf(" %02x", sim.peek(reg));
+    }
+    std::printf(" | %02x\n", sim.peek(bq25155_const::REG_ICCTRL2));
+}
+
+static bool chargeOff(const Bq25155Sim &sim) {
+    return sim.cePinHigh() || (sim.peek(bq25155_const::REG_ICCTRL2) & bq25155_const::CHARGER_DISABLE_MASK) != 0;
+}
+
+// A profile whose burst write is NACKed must return false and leave charge off, whether it was
+// on or off before; the same profile applied without the fault turns it on.
+static bool testFailedWrite(bq25155 &charger) {
+    ChargeProfile base;
+    ChargeProfile next;
+    next.chargeVoltage_mV = 4000;
+    next.chargeCurrent_uA = 50000;
+    next.prechargeCurrent_uA = 10000;
+
+    bool ok = true;
+    for (int chargeWasOn = 0; chargeWasOn < 2; chargeWasOn++) {
+        if (!charger.applyChargeProfile(base)) { ok = false; }
+        if (!chargeWasOn && !charger.DisableCharge()) { ok = false; }
+
+        charger.transport().setWriteFault(bq25155_const::CHARGE_IMAGE_FIRST,
+                                          bq25155_const::CHARGE_IMAGE_FIRST + bq25155_const::CHARGE_IMAGE_LEN - 1);
+        const bool applied = charger.applyChargeProfile(next);
+        charger.transport().clearWriteFault();
+        if (applied || !chargeOff(simA)) {
+            std::printf("failed write (charge was %s): apply %d, /CE %d, ICCTRL2 %02x\n",
+                        chargeWasOn ? "on" : "off", applied, simA.cePinHigh(),
+                        simA.peek(bq25155_const::REG_ICCTRL2));
+            ok = false;
+        }
+
+        if (!charger.applyChargeProfile(next) || chargeOff(simA)) {
+            std::printf("retry after failed write did not enable charge\n");
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+int main() {
+    simA.setVIN(5000);
+    simA.setBatteryOCV(3700);
+    simB.setVIN(5000);
+    simB.setBatteryOCV(3700);
+
+    bq25155 chargerA(SimBus(&simA, 0));
+    bq25155 chargerB(SimBus(&simB, 0));
+    if (!chargerA.begin(PIN_CHEN_A, PIN_INT_A, PIN_LPM_A, CHEMISTRY, true) ||
+        !chargerB.begin(PIN_CHEN_B, PIN_INT_B, PIN_LPM_B, CHEMISTRY, true)) {
+        std::printf("begin failed\n");
+        return 1;
+    }
+
+    int failures = 0;
+    std::srand(7);
+    for (int n = 0; n < PROFILES; n++) {
+        ChargeProfile p;
+        p.chargeVoltage_mV = (uint16_t)(3400 + std::rand() % 1200);
+        p.enableFastCharge = std::rand() % 2;
+        p.chargeCurrent_uA = (uint32_t)(std::rand() % 600000);
+        p.prechargeCurrent_uA = (uint32_t)(std::rand() % 120000);
+        p.inputCurrentLimit = (ILIMLevel)(std::rand() % 8);
+        p.safetyTimer = (SafetyTimerLimit)(std::rand() % 4);
+        p.use2xSafetyTimer = std::rand() % 2;
+        p.ledOnWhenChargeDone = std::rand() % 2;
+
+        const bool okA = chargerA.applyChargeProfile(p);
+        const bool okB = applyWithSetters(chargerB, p);
+        const ChargeImage image = bq25155_const::compileChargeProfile(p, CHEMISTRY);
+
+        bool same = (okA == okB);
+        for (uint8_t i = 0; i < bq25155_const::CHARGE_IMAGE_LEN; i++) {
+            const uint8_t reg = (uint8_t)(bq25155_const::CHARGE_IMAGE_FIRST + i);
+            const uint8_t mask = bq25155_const::CHARGE_IMAGE_MASKS[i];
+            if (simA.peek(reg) != simB.peek(reg)) { same = false; }
+            if ((simA.peek(reg) & mask) != (image.regs[i] & mask)) { same = false; }
+        }
+        if ((simA.peek(bq25155_const::REG_ICCTRL2) & bq25155_const::CHARGER_DISABLE_MASK) !=
+            (simB.peek(bq25155_const::REG_ICCTRL2) & bq25155_const::CHARGER_DISABLE_MASK)) {
+            same = false;
+        }
+        if ((simA.peek(bq25155_const::REG_ICCTRL2) & bq25155_const::CHARGE_IMAGE_ICCTRL2_MASK) !=
+            image.icctrl2) {
+            same = false;
+        }
+
+        if (!same) {
+            std::printf("profile %d differs (apply %d, setters %d)\n", n, okA, okB);
+            dump("image  ", simA);
+            dump("setters", simB);
+            failures++;
+        }
+    }
+
+    if (failures != 0) {
+        std::printf("%d of %d profiles differ\n", failures, PROFILES);
+        return 1;
+    }
+    std::printf("profile: %d profiles match\n", PROFILES);
+
+    if (!testFailedWrite(chargerA)) { return 1; }
+    std::printf("profile: failed writes leave charge off\n");
+    return 0;
+}
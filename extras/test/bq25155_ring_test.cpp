@@ -0,0 +1,127 @@
+/*
+ * @brief         Host test of the bq25155 SPSC ring (bq25155_ring.h)
+ * @note          One std::thread pushes numbered records while another pops and checks
+ *                order and contents; then the single-threaded edge cases (full, empty,
+ *                index wrap). Run it under ThreadSanitizer to check the memory ordering.
+ *
+ *                Build and run from the repository root:
+ *                  g++ -std=gnu++11 -O1 -pthread -fsanitize=thread -Isrc \
+ *                      extras/test/bq25155_ring_test.cpp -o bq25155_ring_test
+ *                  ./bq25155_ring_test
+ *
+ *                Adding -D__AVR__ (without -fsanitize) builds the volatile-index path used on
+ *                8-bit cores; its edge cases are exact, the two-thread part is only a smoke run.
+ *                Exits with status 1 on the first failed check.
+ * @version       1.1.4
+ * @creation date 2026-03-09
+ * @updated date  2026-03-09
+ * @author        jul10199555
+ *
+ * Repo:
+ * https://github.com/jul10199555/bq25155-Arduino-Library
+ *
+ */
+
+#include "bq25155_ring.h"
+
+#include <cstdio>
+#include <thread>
+
+static int failures = 0;
+
+#define CHECK(cond)                                                              \
+    do {                                                                         \
+        if (!(cond)) {                                                           \
+            std::printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);          \
+            failures++;                                                          \
+        }                                                                        \
+    } while (0)
+
+// Same shape as AdcSample: a timestamp and seven raw codes.
+struct Record {
+    uint32_t timestampUs;
+    uint16_t raw[7];
+};
+
+static void testTwoThreads() {
+    static bq25155_ring::SpscRing<Record, 64> ring;
+    const uint32_t count = 200000;
+    uint32_t received = 0;
+    uint32_t bad = 0;
+
+    std::thread producer([&]() {
+        for (uint32_t i = 0; i < count;) {
+            Record r;
+            r.timestampUs = i;
+            for (uint8_t ch = 0; ch < 7; ch++) { r.raw[ch] = (uint16_t)(i * 7 + ch); }
+            if (ring.push(r)) {
+                i++;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+    std::thread consumer([&]() {
+        Record r;
+        while (received < count) {
+            if (!ring.pop(r)) {
+                std::this_thread::yield();
+                continue;
+            }
+            if (r.timestampUs != received) { bad++; }
+            for (uint8_t ch = 0; ch < 7; ch++) {
+                if (r.raw[ch] != (uint16_t)(received * 7 + ch)) { bad++; }
+            }
+            received++;
+        }
+    });
+    producer.join();
+    consumer.join();
+
+    CHECK(received == count);
+    CHECK(bad == 0);
+    CHECK(ring.empty());
+    std::printf("two threads: %u records, %u refused pushes\n", received, ring.dropped());
+}
+
+static void testEdges() {
+    bq25155_ring::SpscRing<int, 8> ring;
+    int v = -1;
+    CHECK(ring.capacity() == 8);
+    CHECK(ring.empty());
+    CHECK(!ring.pop(v));
+    CHECK(!ring.peek(v));
+
+    for (int i = 0; i < 8; i++) { CHECK(ring.push(i)); }
+    CHECK(ring.full());
+    CHECK(!ring.push(99));
+    CHECK(ring.dropped() == 1);
+    CHECK(ring.peek(v) && v == 0);
+    CHECK(ring.size() == 8);
+
+    for (int i = 0; i < 8; i++) { CHECK(ring.pop(v) && v == i); }
+    CHECK(ring.empty());
+
+    // Run the free-running indices past their wrap point.
+    for (int i = 0; i < 70000; i++) {
+        CHECK(ring.push(i));
+        CHECK(ring.pop(v) && v == i);
+        if (failures != 0) { break; }
+    }
+    CHECK(ring.empty());
+
+    // pushTo() is the adapter the driver's sample sink uses.
+    CHECK((bq25155_ring::SpscRing<int, 8>::pushTo(42, &ring)));
+    CHECK(ring.pop(v) && v == 42);
+}
+
+int main() {
+    testEdges();
+    testTwoThreads();
+    if (failures != 0) {
+        std::printf("%d check(s) failed\n", failures);
+        return 1;
+    }
+    std::printf("ring: all checks passed\n");
+    return 0;
+}
@@ -15,11 +15,23 @@
 #include "bq25155.h"
 
 using namespace bq25155_const;
-
-bq25155::bq25155() : _i2cPort(&Wire), _i2cAddress(bq25155_ADDR) {}
-bq25155::bq25155(TwoWire *wire, uint8_t address) : _i2cPort(wire), _i2cAddress(address) {}
-
-bool bq25155::begin(uint8_t CHEN_pin, uint8_t INT_pin, uint8_t LPM_pin, BatteryChemistry chemistry, bool usePGIndicator) {
+#ifndef ARDUINO
+using namespace bq25155_port;
+#endif
+
+// Attributes bus traffic to an instrumented entry point until the enclosing scope exits.
+#if BQ25155_ENABLE_BUS_STATS
+#define BQ25155_BUS_API(api) BusApiScope busApiScope(*this, BusApi::api)
+#else
+#define BQ25155_BUS_API(api)
+#endif
+
+bq25155::bq25155() : _bus(), _i2cAddress(bq25155_ADDR) {}
+bq25155::bq25155(const Transport &bus, uint8_t address) : _bus(bus), _i2cAddress(address) {}
+
+bool bq25155::begin(uint8_t CHEN_pin, uint8_t INT_pin, uint8_t LPM_pin, BatteryChemistry chemistry, bool usePGIndicator,
+                    uint32_t expectedConfigChecksum) {
+    BQ25155_BUS_API(BEGIN);
     if (CHEN_pin == 0xFF || INT_pin == 0xFF || LPM_pin == 0xFF) { return false; }
 
     this->_CHEN_pin = CHEN_pin;
@@ -29,24 +41,54 @@ bool bq25155::begin(uint8_t CHEN_pin, uint8_t INT_pin, uint8_t LPM_pin, BatteryC
     this->_usePGIndicator = usePGIndicator;
     this->_pgLedOnWhenChargeDone = true;
     this->_pgChargeDoneLatched = false;
+    this->_busSessionDepth = 0;
+    this->_configResumed = false;
+    this->_adcCtx.valid = false;
 
     pinMode(this->_LPM_pin, OUTPUT); // Set LPM output pin
 
     digitalWrite(this->_LPM_pin, HIGH); // HIGH to allow I2C communication when VIN is not present
     
-    _i2cPort->begin(); // Initialize I2C communication
-    _i2cPort->beginTransmission(_i2cAddress);
-    
-    if (_i2cPort->endTransmission() == 0) {
+    // Initialize I2C communication
+    bool present = false;
+    if (_bus.begin()) {
+        const uint32_t startUs = busStatsMicros();
+        present = _bus.probe(_i2cAddress);
+        noteBusTransaction(1, startUs, present); // Address only
+    }
+
+    if (present) {
+        BusSession session(*this); // LPM stays HIGH for the whole setup, LOW once it ends
+
         // Check if device is 8b00110101 = bq25155
         if (getDeviceID() != DEVICE_ID_DEF)
             return false;
 
-        pinMode(this->_INT_pin, INPUT); // Set input the Interruption pin (Future Update, integrate Interruption on MCU)
+        // Fill the shadow so the pin/PG setup below and later getters skip the bus.
+        resyncShadow();
+
+        pinMode(this->_INT_pin, INPUT_PULLUP); // INT is open drain: keep the idle line HIGH (see enableInterrupt())
+
+        if (expectedConfigChecksum != CONFIG_CHECKSUM_NONE && getConfigChecksum() == expectedConfigChecksum) {
+            // Already configured (MCU-only reset): keep the charge state the device has. The /CE
+            // level is set before the pin becomes an output so it never glitches.
+            _configResumed = true;
+            const uint8_t icctrl2 = readRegister(REG_ICCTRL2);
+            const bool chargeEnabled = (icctrl2 & CHARGER_DISABLE_MASK) == 0;
+            digitalWrite(this->_CHEN_pin, chargeEnabled ? LOW : HIGH);
+            pinMode(this->_CHEN_pin, OUTPUT);
+
+            if (_usePGIndicator && chargeEnabled) {
+                // Recover the LED polarity from the PG state left by the previous run.
+                _pgChargeDoneLatched = readStatus().chargeDone();
+                _pgLedOnWhenChargeDone = ((icctrl2 & GPO_PG_MASK) == 0) == _pgChargeDoneLatched;
+            }
+            return true;
+        }
+
         pinMode(this->_CHEN_pin, OUTPUT); // Set CHGEN output pin
         
         digitalWrite(this->_CHEN_pin, HIGH); // HIGH to disable charging until applyChargeProfile() is called
-        digitalWrite(this->_LPM_pin, LOW); // LOW to disable I2C communication when VIN is not present.
 
         if (_usePGIndicator) {
             if (!setPGasGPOD()) { return false; }
@@ -67,28 +109,108 @@ BatteryChemistry bq25155::getBatteryChemistry() const {
 }
 
 bool bq25155::applyChargeProfile(const ChargeProfile &profile) {
+    BQ25155_BUS_API(APPLY_CHARGE_PROFILE);
     _pgLedOnWhenChargeDone = profile.ledOnWhenChargeDone;
     resetPGLatchForNewChargeCycle();
+    // Pure computation, same clamping as the individual setters.
+    return writeChargeImage(compileChargeProfile(profile, _batteryChemistry));
+}
 
-    if (!setChargeVoltage(profile.chargeVoltage_mV)) { return false; }
-    if (profile.enableFastCharge) {
-        if (!EnableFastCharge()) { return false; }
-    } else {
-        if (!DisableFastCharge()) { return false; }
+bool bq25155::applyChargeImage(const ChargeImage &image) {
+    BQ25155_BUS_API(APPLY_CHARGE_PROFILE);
+    if ((image.regs[REG_VBAT_CTRL - CHARGE_IMAGE_FIRST] & VBAT_REG_MASK) >
+        vbatRegCode(getChemistryMaxChargeVoltage_mV(), _batteryChemistry)) {
+        return false;
+    }
+    // GPO_PG High Z at the start of a cycle means the LED marks charge done.
+    _pgLedOnWhenChargeDone = (image.icctrl2 & GPO_PG_MASK) != 0;
+    resetPGLatchForNewChargeCycle();
+    return writeChargeImage(image);
+}
+
+bool bq25155::writeChargeImage(const ChargeImage &image) {
+    BusSession session(*this); // One LPM window for the whole profile
+    const uint8_t icctrl2Mask = _usePGIndicator ? CHARGE_IMAGE_ICCTRL2_MASK : CHARGER_DISABLE_MASK;
+
+    if (_stageDepth != 0) {
+        // Inside a ConfigTransaction: stage the changed fields, the commit writes and verifies.
+        bool ok = true;
+        for (uint8_t i = 0; i < CHARGE_IMAGE_LEN; i++) {
+            const uint8_t reg = CHARGE_IMAGE_FIRST + i;
+            const uint8_t value = readRegister(reg);
+            const uint8_t want = (value & ~CHARGE_IMAGE_MASKS[i]) | (image.regs[i] & CHARGE_IMAGE_MASKS[i]);
+            if (want != value) { ok = writeRegister(reg, want) && ok; }
+        }
+        // Charge stays as it is until the new limits are on the device: the commit enables it.
+        _stageEnableCharge = true;
+        return ok;
+    }
+
+    // Device state, not the shadow: the image is also used to repair registers after a reset.
+    uint8_t current[CHARGE_IMAGE_LEN];
+    uint8_t icctrl2 = 0;
+    if (!readRegisters(CHARGE_IMAGE_FIRST, current, CHARGE_IMAGE_LEN) ||
+        !readRegisters(REG_ICCTRL2, &icctrl2, 1)) {
+        return false;
+    }
+    for (uint8_t i = 0; i < CHARGE_IMAGE_LEN; i++) { updateShadow(CHARGE_IMAGE_FIRST + i, current[i]); }
+    updateShadow(REG_ICCTRL2, icctrl2);
+
+    uint8_t target[CHARGE_IMAGE_LEN];
+    uint8_t changed = 0; // Bit per image byte
+    for (uint8_t i = 0; i < CHARGE_IMAGE_LEN; i++) {
+        target[i] = (current[i] & ~CHARGE_IMAGE_MASKS[i]) | (image.regs[i] & CHARGE_IMAGE_MASKS[i]);
+        if (target[i] != current[i]) { changed |= (uint8_t)(1U << i); }
     }
 
-    if (!setILIM(profile.inputCurrentLimit)) { return false; }
-    if (!setChargeCurrent(profile.chargeCurrent_uA)) { return false; }
-    if (!setPreChargeCurrent(profile.prechargeCurrent_uA)) { return false; }
+    bool ok = true;
+    if (changed != 0) {
+        // Charge off through /CE (no bus traffic) while the new limits go in.
+        openChargeOffWindow();
+        digitalWrite(this->_CHEN_pin, HIGH);
+
+        uint8_t first = CHARGE_IMAGE_LEN;
+        uint8_t last = 0;
+        uint8_t i = 0;
+        while (i < CHARGE_IMAGE_LEN) {
+            if ((changed & (1U << i)) == 0) { i++; continue; }
+            // Bridge short unchanged gaps (rewritten with their current value) into one burst.
+            uint8_t runEnd = i;
+            for (uint8_t next = i + 1; next < CHARGE_IMAGE_LEN && (next - runEnd) <= STAGE_BRIDGE_GAP + 1; next++) {
+                if ((changed & (1U << next)) != 0) { runEnd = next; }
+            }
+            if (!writeRegisters(CHARGE_IMAGE_FIRST + i, &target[i], runEnd - i + 1)) { ok = false; }
+            if (i < first) { first = i; }
+            last = runEnd;
+            i = runEnd + 1;
+        }
 
-    if (!setChgSafetyTimer(profile.safetyTimer)) { return false; }
-    if (profile.use2xSafetyTimer) {
-        if (!set2xSafetyTimer()) { return false; }
+        // One read-back burst over everything written, still with charge off.
+        uint8_t readBack[CHARGE_IMAGE_LEN];
+        if (ok && readRegisters(CHARGE_IMAGE_FIRST + first, readBack, last - first + 1)) {
+            for (uint8_t k = first; k <= last; k++) {
+                if (((readBack[k - first] ^ target[k]) & CHARGE_IMAGE_MASKS[k]) != 0) { ok = false; }
+                updateShadow(CHARGE_IMAGE_FIRST + k, readBack[k - first]);
+            }
+        } else {
+            ok = false;
+        }
+        if (!ok) {
+            // Half-written or unverified limits: /CE stays HIGH, charge stays off.
+            closeChargeOffWindow();
+            return false;
+        }
+        digitalWrite(this->_CHEN_pin, LOW); // LOW to Enable charging
+        closeChargeOffWindow();
     } else {
-        if (!set1xSafetyTimer()) { return false; }
+        digitalWrite(this->_CHEN_pin, LOW); // LOW to Enable charging
     }
 
-    return EnableCharge();
+    const uint8_t wantIcctrl2 = (icctrl2 & ~icctrl2Mask) | (image.icctrl2 & icctrl2Mask);
+    if (wantIcctrl2 != icctrl2 && !writeRegister(REG_ICCTRL2, wantIcctrl2)) {
+        ok = false;
+    }
+    return ok;
 }
 
 void bq25155::resetPGLatchForNewChargeCycle() {
@@ -107,29 +229,44 @@ bool bq25155::refreshPGIndicatorFromState() {
         return true;
     }
 
-    if (!isChargeEnabled()) {
-        return DisablePG();
+    // CHARGER_DISABLE and GPO_PG share ICCTRL2: one (shadowed) read covers both.
+    const uint8_t r = readRegister(REG_ICCTRL2);
+    const bool chargeEnabled = (r & CHARGER_DISABLE_MASK) == 0;
+    const bool ledOn = chargeEnabled &&
+                       (_pgLedOnWhenChargeDone ? _pgChargeDoneLatched : !_pgChargeDoneLatched);
+    // GPO_PG: 1b0 = pulled down (LED on), 1b1 = High Z. Only write when the pin changes.
+    const uint8_t want = ledOn ? (uint8_t)(r & ~GPO_PG_MASK) : (uint8_t)(r | GPO_PG_MASK);
+    if (want == r) {
+        return true;
     }
-
-    const bool ledOn = _pgLedOnWhenChargeDone ? _pgChargeDoneLatched : !_pgChargeDoneLatched;
-    return ledOn ? EnablePG() : DisablePG();
+    return writeRegister(REG_ICCTRL2, want);
 }
 
 uint16_t bq25155::getChemistryMaxChargeVoltage_mV() const {
-    switch (_batteryChemistry) {
-        case BatteryChemistry::LI_HV_4V35: return 4350;
-        case BatteryChemistry::LI_HV_4V4:  return 4400;
-        case BatteryChemistry::LI_ION_4V2:
-        default: return 4200;
-    }
+    return chemistryMaxChargeVoltage_mV(_batteryChemistry);
 }
 
 bool bq25155::enterChargeReconfig() {
-    if (_chargeReconfigDepth == 0) {
+    beginBusSession(); // Keep LPM high until the matching exitChargeReconfig()
+    // While a ConfigTransaction stages writes, nothing reaches the charger yet:
+    // commitConfigTransaction() opens the charge-off window once for the whole batch.
+    if (_chargeReconfigDepth == 0 && _stageDepth == 0) {
+#if BQ25155_USE_SHADOW
+        if (_chargeReconfigMode == ChargeReconfigMode::STAGED_WINDOW) {
+            // The whole setter chain becomes one transaction, committed by exitChargeReconfig().
+            _reconfigOwnsTransaction = beginConfigTransaction();
+            _chargeReconfigDepth++;
+            return true;
+        }
+#endif
         _resumeChargeAfterConfig = isChargeEnabled();
-        if (_resumeChargeAfterConfig && !DisableCharge()) {
-            _resumeChargeAfterConfig = false;
-            return false;
+        if (_resumeChargeAfterConfig) {
+            openChargeOffWindow();
+            if (!DisableCharge()) {
+                _resumeChargeAfterConfig = false;
+                endBusSession();
+                return false;
+            }
         }
     }
     _chargeReconfigDepth++;
@@ -143,77 +280,684 @@ bool bq25155::exitChargeReconfig(bool success) {
 
     _chargeReconfigDepth--;
     if (_chargeReconfigDepth != 0) {
+        endBusSession();
+        return success;
+    }
+
+    if (_reconfigOwnsTransaction) {
+        _reconfigOwnsTransaction = false;
+        if (success) {
+            success = commitConfigTransaction();
+        } else {
+            abortConfigTransaction(); // A failed setter chain leaves the device untouched
+        }
+        endBusSession();
         return success;
     }
 
     bool resumeOk = true;
     if (_resumeChargeAfterConfig) {
         resumeOk = EnableCharge();
+        closeChargeOffWindow();
     }
     _resumeChargeAfterConfig = false;
+    endBusSession();
 
     return success && resumeOk;
 }
 
+void bq25155::openChargeOffWindow() {
+    _chargeOffStartUs = micros();
+}
+
+void bq25155::closeChargeOffWindow() {
+    _lastChargeOffUs = micros() - _chargeOffStartUs;
+    if (_lastChargeOffUs > _maxChargeOffUs) { _maxChargeOffUs = _lastChargeOffUs; }
+}
+
+bool bq25155::setChargeReconfigMode(ChargeReconfigMode mode) {
+#if !BQ25155_USE_SHADOW
+    if (mode == ChargeReconfigMode::STAGED_WINDOW) { return false; } // Staging needs the shadow
+#endif
+    if (_chargeReconfigDepth != 0) { return false; } // Not in the middle of a setter chain
+    _chargeReconfigMode = mode;
+    return true;
+}
+
+ChargeReconfigMode bq25155::getChargeReconfigMode() const { return _chargeReconfigMode; }
+uint32_t bq25155::getLastChargeOffWindowUs() const { return _lastChargeOffUs; }
+uint32_t bq25155::getMaxChargeOffWindowUs() const { return _maxChargeOffUs; }
+
+void bq25155::resetChargeOffWindowStats() {
+    _lastChargeOffUs = 0;
+    _maxChargeOffUs = 0;
+}
+
+void bq25155::beginBusSession() {
+    if (_busSessionDepth == 0) {
+        digitalWrite(this->_LPM_pin, HIGH); // HIGH to allow I2C communication when VIN is not present
+        noteLpmToggle();
+    }
+    if (_busSessionDepth < 0xFF) { _busSessionDepth++; }
+}
+
+void bq25155::endBusSession() {
+    if (_busSessionDepth == 0) { return; }
+    _busSessionDepth--;
+    if (_busSessionDepth == 0) {
+        digitalWrite(this->_LPM_pin, LOW); // LOW to disable I2C communication when VIN is not present.
+        noteLpmToggle();
+    }
+}
+
+// --- Begin Bus Statistics ---
+#if BQ25155_ENABLE_BUS_STATS
+bq25155::BusApiScope::BusApiScope(bq25155 &dev, BusApi api)
+    : _dev(dev), _index(static_cast<uint8_t>(api)), _outer(false), _startUs(micros()) {
+    _dev._busStats[_index].calls++;
+    const uint32_t bit = 1UL << _index;
+    if ((_dev._busApiActive & bit) == 0) { // Re-entries leave timing to the outer scope
+        _dev._busApiActive |= bit;
+        _outer = true;
+    }
+}
+
+bq25155::BusApiScope::~BusApiScope() {
+    if (!_outer) { return; }
+    _dev._busApiActive &= ~(1UL << _index);
+    _dev._busStats[_index].callMicros += micros() - _startUs;
+}
+#endif
+
+uint32_t bq25155::busStatsMicros() const {
+#if BQ25155_ENABLE_BUS_STATS
+    return micros();
+#else
+    return 0;
+#endif
+}
+
+void bq25155::noteBusTransaction(uint8_t wireBytes, uint32_t startUs, bool ok) {
+    if (ok && _wdKeeper.timeoutMs != 0) {
+        // Every completed transaction feeds the watchdog (a NACKed one may never have reached
+        // the device); the gap since the previous one is its margin.
+        const uint32_t now = millis();
+        const int32_t margin = (int32_t)_wdKeeper.timeoutMs - (int32_t)(now - _wdKeeper.lastActivityMs);
+        if (margin < _wdKeeper.minMarginMs) { _wdKeeper.minMarginMs = margin; }
+        _wdKeeper.lastActivityMs = now;
+    }
+#if BQ25155_ENABLE_BUS_STATS
+    const uint32_t elapsed = micros() - startUs;
+    _busStatsTotal.transactions++;
+    _busStatsTotal.bytes += wireBytes;
+    _busStatsTotal.busMicros += elapsed;
+
+    const uint32_t active = (_busApiActive != 0) ? _busApiActive
+                                                 : (1UL << static_cast<uint8_t>(BusApi::OTHER));
+    for (uint8_t i = 0; i < BUS_API_COUNT; i++) {
+        if ((active & (1UL << i)) == 0) { continue; }
+        _busStats[i].transactions++;
+        _busStats[i].bytes += wireBytes;
+        _busStats[i].busMicros += elapsed;
+    }
+#else
+    (void)wireBytes;
+    (void)startUs;
+#endif
+}
+
+void bq25155::noteLpmToggle() {
+#if BQ25155_ENABLE_BUS_STATS
+    _busStatsTotal.lpmToggles++;
+    const uint32_t active = (_busApiActive != 0) ? _busApiActive
+                                                 : (1UL << static_cast<uint8_t>(BusApi::OTHER));
+    for (uint8_t i = 0; i < BUS_API_COUNT; i++) {
+        if ((active & (1UL << i)) != 0) { _busStats[i].lpmToggles++; }
+    }
+#endif
+}
+
+BusStats bq25155::getBusStats(BusApi api) const {
+#if BQ25155_ENABLE_BUS_STATS
+    const uint8_t i = static_cast<uint8_t>(api);
+    return (i < BUS_API_COUNT) ? _busStats[i] : BusStats();
+#else
+    (void)api;
+    return BusStats();
+#endif
+}
+
+BusStats bq25155::getBusStats() const {
+#if BQ25155_ENABLE_BUS_STATS
+    return _busStatsTotal;
+#else
+    return BusStats();
+#endif
+}
+
+void bq25155::resetBusStats() {
+#if BQ25155_ENABLE_BUS_STATS
+    for (uint8_t i = 0; i < BUS_API_COUNT; i++) { _busStats[i] = BusStats(); }
+    _busStatsTotal = BusStats();
+#endif
+}
+// --- End Bus Statistics ---
+
+// --- Begin Shadow Register File ---
+// Position of reg inside _shadow, or SHADOW_NONE if reg is not a shadowed R/W register.
+uint8_t bq25155::shadowIndex(uint8_t reg) {
+    uint8_t base = 0;
+    for (uint8_t i = 0; i < SHADOW_RANGE_COUNT; i++) {
+        const RegisterRange &r = SHADOW_RANGES[i];
+        if (reg < r.first) { break; }
+        if (reg <= r.last) { return base + (reg - r.first); }
+        base += r.last - r.first + 1;
+    }
+    return SHADOW_NONE;
+}
+
+// Bits the device changes on its own. They are never cached (always stored as 0).
+uint8_t bq25155::volatileBits(uint8_t reg) {
+    switch (reg) {
+        case REG_ADCCTRL0: return ADC_CONV_START_MASK; // Goes back to 0 when conversion is complete
+        case REG_ICCTRL0:  return HW_RESET_MASK | SW_RESET_MASK;
+        default: return 0x00;
+    }
+}
+
+void bq25155::updateShadow(uint8_t reg, uint8_t value) {
+#if BQ25155_USE_SHADOW
+    const uint8_t idx = shadowIndex(reg);
+    if (idx == SHADOW_NONE) { return; }
+    _shadow[idx] = value & ~volatileBits(reg);
+    _shadowValid |= (1UL << idx);
+#else
+    (void)reg;
+    (void)value;
+#endif
+}
+
+void bq25155::invalidateShadow() {
+#if BQ25155_USE_SHADOW
+    _shadowValid = 0;
+#endif
+}
+
+bool bq25155::resyncShadow() {
+    BQ25155_BUS_API(RESYNC_SHADOW);
+#if BQ25155_USE_SHADOW
+    _shadowValid = 0;
+    _shadowValid = readConfigSpace(_shadow);
+    return _shadowValid == CONFIG_SPACE_ALL;
+#else
+    return false;
+#endif
+}
+
+// Reads the R/W configuration space into image (indexed like the shadow, volatile bits
+// cleared) and returns the indices that were read. Neighbouring ranges share a burst.
+uint32_t bq25155::readConfigSpace(uint8_t *image) {
+    BusSession session(*this);
+
+    uint32_t valid = 0;
+    uint8_t base = 0;
+    uint8_t i = 0;
+    while (i < SHADOW_RANGE_COUNT) {
+        // Merge neighbouring ranges across short reserved gaps into a single burst.
+        const uint8_t first = SHADOW_RANGES[i].first;
+        uint8_t last = SHADOW_RANGES[i].last;
+        uint8_t next = i + 1;
+        while (next < SHADOW_RANGE_COUNT &&
+               (SHADOW_RANGES[next].first - last) <= SHADOW_MERGE_GAP &&
+               (SHADOW_RANGES[next].last - first + 1) <= SHADOW_SYNC_SPAN_MAX) {
+            last = SHADOW_RANGES[next].last;
+            next++;
+        }
+
+        uint8_t buf[SHADOW_SYNC_SPAN_MAX];
+        const bool ok = readRegisters(first, buf, last - first + 1);
+        for (uint8_t k = i; k < next; k++) {
+            for (uint8_t reg = SHADOW_RANGES[k].first; reg <= SHADOW_RANGES[k].last; reg++) {
+                if (ok) {
+                    image[base] = buf[reg - first] & ~volatileBits(reg);
+                    valid |= 1UL << base;
+                }
+                base++;
+            }
+        }
+        i = next;
+    }
+    return valid;
+}
+
+// CRC-16/CCITT-FALSE over a configuration image. The driver-owned ICCTRL2 bits (charge
+// enable, PG LED state) change at runtime and are left out.
+uint16_t bq25155::configChecksum(const uint8_t *image) {
+    uint16_t crc = 0xFFFF;
+    const uint8_t icctrl2 = shadowIndex(REG_ICCTRL2);
+    for (uint8_t idx = 0; idx < SHADOW_REG_COUNT; idx++) {
+        uint8_t value = image[idx];
+        if (idx == icctrl2) { value &= ~(CHARGER_DISABLE_MASK | GPO_PG_MASK); }
+        crc ^= (uint16_t)value << 8;
+        for (uint8_t b = 0; b < 8; b++) {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+uint32_t bq25155::getConfigChecksum() {
+#if BQ25155_USE_SHADOW
+    if (_shadowValid != CONFIG_SPACE_ALL && !resyncShadow()) { return CONFIG_CHECKSUM_NONE; }
+    return configChecksum(_shadow);
+#else
+    uint8_t image[SHADOW_REG_COUNT];
+    if (readConfigSpace(image) != CONFIG_SPACE_ALL) { return CONFIG_CHECKSUM_NONE; }
+    return configChecksum(image);
+#endif
+}
+
+bool bq25155::wasConfigResumed() const {
+    return _configResumed;
+}
+// --- End Shadow Register File ---
+
+// --- Begin Config Transaction ---
+// Bits that trigger an action and therefore bypass staging (charge enable, conversion start, resets).
+uint8_t bq25155::immediateBits(uint8_t reg) {
+    switch (reg) {
+        case REG_ICCTRL2:  return CHARGER_DISABLE_MASK;
+        case REG_ADCCTRL0: return ADC_CONV_START_MASK;
+        case REG_ICCTRL0:  return HW_RESET_MASK | SW_RESET_MASK;
+        default: return 0x00;
+    }
+}
+
+bool bq25155::beginConfigTransaction() {
+#if BQ25155_USE_SHADOW
+    if (_stageDepth == 0) {
+        _stageDirty = 0;
+        _stageEnableCharge = false;
+    }
+    if (_stageDepth < 0xFF) { _stageDepth++; }
+    return true;
+#else
+    return false; // Staging is built on the shadow register file
+#endif
+}
+
+void bq25155::abortConfigTransaction() {
+    _stageDepth = 0;
+    _stageEnableCharge = false;
+#if BQ25155_USE_SHADOW
+    _stageDirty = 0;
+#endif
+}
+
+bool bq25155::isConfigTransactionActive() const {
+    return _stageDepth != 0;
+}
+
+#if BQ25155_USE_SHADOW
+// Returns true if the write was staged, false if it must go to the bus now.
+bool bq25155::stageWrite(uint8_t reg, uint8_t value) {
+    const uint8_t idx = shadowIndex(reg);
+    if (idx == SHADOW_NONE) { return false; }
+    const uint32_t bit = 1UL << idx;
+
+    // Staged value, shadow, or a device read that also fills the shadow baseline for the diff.
+    const uint8_t current = readRegister(reg);
+    if (((value ^ current) & immediateBits(reg)) != 0 || (value & volatileBits(reg)) != 0) {
+        _stageDirty &= ~bit; // The full value (staged bits included) is written right away
+        return false;
+    }
+
+    _stage[idx] = value;
+    _stageDirty |= bit;
+    return true;
+}
+
+// Writes every changed register, merging neighbours into auto-increment bursts, then
+// reads each burst back once to verify it. With chargeOffWindow, /CE is high only from the
+// first burst write to the last one; the verify reads run with charge back on.
+bool bq25155::writeStagedRuns(uint32_t changed, bool chargeOffWindow) {
+    bool ok = true;
+    uint32_t written = 0;   // Shadow indices written successfully
+    uint32_t runStarts = 0; // Shadow index of the first register of each burst
+    uint8_t base = 0;
+
+    if (chargeOffWindow) {
+        openChargeOffWindow();
+        digitalWrite(this->_CHEN_pin, HIGH); // HIGH to Disable charging
+    }
+
+    for (uint8_t r = 0; r < SHADOW_RANGE_COUNT; r++) {
+        const RegisterRange &range = SHADOW_RANGES[r];
+        uint8_t reg = range.first;
+
+        while (reg <= range.last) {
+            if ((changed & (1UL << (base + reg - range.first))) == 0) {
+                reg++;
+                continue;
+            }
+
+            // Extend the run; bridge short gaps of known (shadow-valid) registers so two
+            // nearby changes cost one transaction instead of two.
+            const uint8_t runStart = reg;
+            uint8_t runEnd = reg;
+            uint8_t next = reg + 1;
+            while (next <= range.last) {
+                const uint32_t nextBit = 1UL << (base + next - range.first);
+                if ((changed & nextBit) != 0) {
+                    runEnd = next++;
+                    continue;
+                }
+                if ((_shadowValid & nextBit) == 0 || (next - runEnd) > STAGE_BRIDGE_GAP) { break; }
+                next++;
+            }
+
+            uint8_t data[SHADOW_SYNC_SPAN_MAX];
+            const uint8_t len = runEnd - runStart + 1;
+            for (uint8_t i = 0; i < len; i++) {
+                const uint8_t idx = base + runStart + i - range.first;
+                uint8_t value = ((changed & (1UL << idx)) != 0) ? _stage[idx] : _shadow[idx];
+                if (runStart + i == REG_ICCTRL2) {
+                    // Charge enable state is never staged: keep whatever the device has now.
+                    value = (value & ~CHARGER_DISABLE_MASK) | (_shadow[idx] & CHARGER_DISABLE_MASK);
+                }
+                data[i] = value;
+            }
+
+            if (writeRegisters(runStart, data, len)) {
+                const uint8_t first = base + runStart - range.first;
+                written |= ((1UL << len) - 1) << first;
+                runStarts |= 1UL << first;
+            } else {
+                ok = false;
+            }
+            reg = runEnd + 1;
+        }
+        base += range.last - range.first + 1;
+    }
+
+    if (chargeOffWindow) {
+        digitalWrite(this->_CHEN_pin, LOW); // LOW to Enable charging
+        closeChargeOffWindow();
+    }
+
+    // writeRegisters() left the written bytes in the shadow: verify each burst against it.
+    base = 0;
+    for (uint8_t r = 0; r < SHADOW_RANGE_COUNT; r++) {
+        const RegisterRange &range = SHADOW_RANGES[r];
+        for (uint8_t reg = range.first; reg <= range.last; reg++) {
+            const uint8_t first = base + reg - range.first;
+            if ((runStarts & (1UL << first)) == 0) { continue; }
+
+            uint8_t len = 1;
+            while (reg + len <= range.last && (written & (1UL << (first + len))) != 0 &&
+                   (runStarts & (1UL << (first + len))) == 0) {
+                len++;
+            }
+
+            uint8_t readBack[SHADOW_SYNC_SPAN_MAX];
+            if (!readRegisters(reg, readBack, len)) {
+                ok = false;
+                _shadowValid &= ~(((1UL << len) - 1) << first);
+            } else {
+                for (uint8_t i = 0; i < len; i++) {
+                    const uint8_t vreg = reg + i;
+                    if (((readBack[i] ^ _shadow[first + i]) & ~volatileBits(vreg)) != 0) { ok = false; }
+                    updateShadow(vreg, readBack[i]);
+                }
+            }
+            reg += len - 1;
+        }
+        base += range.last - range.first + 1;
+    }
+    return ok;
+}
+
+// Writes the shadow image (the last committed configuration) back over whatever the device
+// holds now, e.g. its reset defaults. Only registers that differ are written.
+bool bq25155::restoreConfigImage() {
+    BusSession session(*this);
+    uint8_t device[SHADOW_REG_COUNT];
+    if (readConfigSpace(device) != CONFIG_SPACE_ALL) { return false; }
+
+    const uint8_t icctrl2 = shadowIndex(REG_ICCTRL2);
+    const bool committedChargeEnabled = (_shadowValid & (1UL << icctrl2)) == 0 ||
+                                        (_shadow[icctrl2] & CHARGER_DISABLE_MASK) == 0;
+    uint32_t changed = 0;
+    for (uint8_t idx = 0; idx < SHADOW_REG_COUNT; idx++) {
+        const uint32_t bit = 1UL << idx;
+        if ((_shadowValid & bit) != 0 && _shadow[idx] != device[idx]) {
+            _stage[idx] = _shadow[idx];
+            changed |= bit;
+        }
+        _shadow[idx] = device[idx]; // Device state is the baseline for the write runs
+    }
+    _shadowValid = CONFIG_SPACE_ALL;
+    if (changed == 0) { return true; }
+
+    // Charge enable is not part of the staged image: match it first (or last) explicitly.
+    bool ok = true;
+    if (!committedChargeEnabled && isChargeEnabled()) { ok = DisableCharge(); }
+    const bool chargeOff = (changed & chargeRegisterBits()) != 0 && isChargeEnabled();
+    ok = writeStagedRuns(changed, chargeOff) && ok;
+    if (committedChargeEnabled && !isChargeEnabled()) { ok = EnableCharge() && ok; }
+    return ok;
+}
+#endif
+
+// Shadow indices of VBAT_CTRL..ILIMCTRL (0x12-0x19), the registers rewritten with charge off.
+uint32_t bq25155::chargeRegisterBits() {
+    return ((1UL << (REG_ILIMCTRL - REG_VBAT_CTRL + 1)) - 1) << shadowIndex(REG_VBAT_CTRL);
+}
+
+bool bq25155::commitConfigTransaction() {
+    BQ25155_BUS_API(COMMIT_CONFIG_TRANSACTION);
+#if BQ25155_USE_SHADOW
+    if (_stageDepth == 0) { return false; }
+    if (_stageDepth > 1) {
+        _stageDepth--; // Joined an outer transaction: it commits everything
+        return true;
+    }
+    _stageDepth = 0;
+    const bool enableCharge = _stageEnableCharge; // A staged charge image ends with charge on
+    _stageEnableCharge = false;
+
+    // Only registers whose staged byte differs from the device are written.
+    uint32_t changed = 0;
+    for (uint8_t idx = 0; idx < SHADOW_REG_COUNT; idx++) {
+        const uint32_t bit = 1UL << idx;
+        if ((_stageDirty & bit) == 0) { continue; }
+        if ((_shadowValid & bit) == 0 || _stage[idx] != _shadow[idx]) {
+            changed |= bit;
+        }
+    }
+    _stageDirty = 0;
+    if (changed == 0) { return enableCharge ? EnableCharge() : true; }
+
+    BusSession session(*this);
+
+    bool ok = true;
+    const bool needsChargeOff = (changed & chargeRegisterBits()) != 0;
+    if (needsChargeOff && _chargeReconfigMode == ChargeReconfigMode::STAGED_WINDOW) {
+        // /CE only, around the burst writes; CHARGER_DISABLE and PG are left alone.
+        ok = writeStagedRuns(changed, isChargeEnabled());
+    } else if (needsChargeOff) {
+        if (!enterChargeReconfig()) { return false; }
+        ok = exitChargeReconfig(writeStagedRuns(changed, false));
+    } else {
+        ok = writeStagedRuns(changed, false);
+    }
+    // Only once the verified image is on the device, and not after a failed write.
+    return (ok && enableCharge) ? EnableCharge() : ok;
+#else
+    return false;
+#endif
+}
+// --- End Config Transaction ---
+
 bool bq25155::writeRegister(uint8_t reg, uint8_t value) {
-    digitalWrite(this->_LPM_pin, HIGH); // HIGH to allow I2C communication when VIN is not present
+#if BQ25155_USE_SHADOW
+    if (_stageDepth != 0 && stageWrite(reg, value)) {
+        return true; // Deferred to commitConfigTransaction()
+    }
+#endif
 
-    _i2cPort->beginTransmission(_i2cAddress);
-    _i2cPort->write(reg);
-    _i2cPort->write(value);
-    uint8_t finishedi2c = _i2cPort->endTransmission();
-    
-    digitalWrite(this->_LPM_pin, LOW); // LOW to disable I2C communication when VIN is not present.
+    bool ok = writeRegisters(reg, &value, 1);
+
+    if (ok && reg == REG_ICCTRL0 && (value & (HW_RESET_MASK | SW_RESET_MASK)) != 0) {
+        invalidateShadow(); // Every I2C register goes back to its default
+        _adcCtx.valid = false;
+    }
 
     // Returns true if I2C write succeeded, otherwise false 
-    return (finishedi2c == 0);
+    return ok;
+}
+
+// Burst write using the register auto-increment. Bursts are split so that the register
+// address plus data never exceed BQ25155_I2C_MAX_BURST bytes of Wire buffer.
+bool bq25155::writeRegisters(uint8_t startReg, const uint8_t *data, uint8_t len) {
+    if (data == nullptr || len == 0) { return false; }
+
+    beginBusSession(); // LPM only toggles here when no session is open
+
+    bool ok = true;
+    uint8_t offset = 0;
+    while (ok && offset < len) {
+        uint8_t chunk = len - offset;
+        if (chunk > BQ25155_I2C_MAX_BURST - 1) { chunk = BQ25155_I2C_MAX_BURST - 1; }
+
+        const uint32_t startUs = busStatsMicros();
+        ok = _bus.write(_i2cAddress, (uint8_t)(startReg + offset), data + offset, chunk);
+        noteBusTransaction(2 + chunk, startUs, ok); // Address + register + data
+        offset += chunk;
+    }
+
+    endBusSession();
+
+    if (ok) {
+        noteAdcContextWrite(startReg, data, len);
+    } else {
+        _adcCtx.valid = false; // Reloaded on the next ADC read
+    }
+
+#if BQ25155_USE_SHADOW
+    for (uint8_t i = 0; i < len; i++) {
+        const uint8_t reg = startReg + i;
+        if (ok) {
+            updateShadow(reg, data[i]);
+        } else {
+            // Unknown register state after a failed write: drop it from the shadow.
+            const uint8_t idx = shadowIndex(reg);
+            if (idx != SHADOW_NONE) { _shadowValid &= ~(1UL << idx); }
+        }
+    }
+#endif
+
+    return ok;
 }
 
 bool bq25155::writeRegisterVerify(uint8_t reg, uint8_t value, uint8_t verifyMask) {
     if (!writeRegister(reg, value)) {
         return false;
     }
-    uint8_t readBack = readRegister(reg);
+#if BQ25155_USE_SHADOW
+    const uint8_t idx = shadowIndex(reg);
+    if (_stageDepth != 0 && idx != SHADOW_NONE && (_stageDirty & (1UL << idx)) != 0) {
+        return true; // Staged: commitConfigTransaction() verifies the burst
+    }
+#endif
+    uint8_t readBack = 0x00; // Verify against the device, not the shadow
+    if (!readRegisters(reg, &readBack, 1)) {
+#if BQ25155_USE_SHADOW
+        // The write went out but its result is unknown: the next access re-reads it.
+        const uint8_t idx = shadowIndex(reg);
+        if (idx != SHADOW_NONE) { _shadowValid &= ~(1UL << idx); }
+#endif
+        return false;
+    }
+    updateShadow(reg, readBack);
     return (((readBack ^ value) & verifyMask) == 0);
 }
 
 uint8_t bq25155::readRegister(uint8_t reg) {
-    digitalWrite(this->_LPM_pin, HIGH); // HIGH to allow I2C communication when VIN is not present
-
-    _i2cPort->beginTransmission(_i2cAddress);
-    _i2cPort->write(reg);
-    uint8_t txStatus = _i2cPort->endTransmission(false); // Send restart
-    if (txStatus != 0) {
-        digitalWrite(this->_LPM_pin, LOW); // LOW to disable I2C communication when VIN is not present.
-        return 0x00;
+#if BQ25155_USE_SHADOW
+    const uint8_t idx = shadowIndex(reg);
+    if (idx != SHADOW_NONE && _stageDepth != 0 && (_stageDirty & (1UL << idx)) != 0) {
+        return _stage[idx]; // Setters see values staged earlier in the same transaction
     }
+    if (idx != SHADOW_NONE && (_shadowValid & (1UL << idx)) != 0) {
+        return _shadow[idx];
+    }
+    uint8_t valuei2c = 0x00;
+    if (readRegisters(reg, &valuei2c, 1) && idx != SHADOW_NONE) {
+        updateShadow(reg, valuei2c);
+    }
+    return valuei2c;
+#else
+    return readRegisterUncached(reg);
+#endif
+}
 
-    uint8_t requested = _i2cPort->requestFrom(_i2cAddress, (size_t)1);
-    if (requested != 1 || !_i2cPort->available()) {
-        digitalWrite(this->_LPM_pin, LOW); // LOW to disable I2C communication when VIN is not present.
-        return 0x00;
+// Always goes to the bus (status bits, self-clearing bits, verify read-back).
+uint8_t bq25155::readRegisterUncached(uint8_t reg) {
+    uint8_t valuei2c = 0x00;
+    readRegisters(reg, &valuei2c, 1); // Leaves 0x00 on failure
+    return valuei2c;
+}
+
+// Burst read using the bq25155 register auto-increment: one address write + one read
+// of len bytes. Bursts longer than BQ25155_I2C_MAX_BURST are split. On failure the
+// whole buffer is zeroed, matching readRegister() returning 0x00.
+bool bq25155::readRegisters(uint8_t startReg, uint8_t *buf, uint8_t len) {
+    if (buf == nullptr || len == 0) { return false; }
+
+    beginBusSession(); // LPM only toggles here when no session is open
+
+    bool ok = true;
+    uint8_t offset = 0;
+    while (ok && offset < len) {
+        uint8_t chunk = len - offset;
+        if (chunk > BQ25155_I2C_MAX_BURST) { chunk = BQ25155_I2C_MAX_BURST; }
+
+        const uint32_t startUs = busStatsMicros();
+        ok = _bus.read(_i2cAddress, (uint8_t)(startReg + offset), buf + offset, chunk);
+        noteBusTransaction(3 + chunk, startUs, ok); // Address + register + address + data
+        offset += chunk;
     }
 
-    uint8_t valuei2c = _i2cPort->read();
-    digitalWrite(this->_LPM_pin, LOW); // LOW to disable I2C communication when VIN is not present.
+    endBusSession();
 
-    return valuei2c;
+    if (!ok) {
+        for (uint8_t i = 0; i < len; i++) { buf[i] = 0x00; }
+        _adcCtx.valid = false; // The device may have reset: reload the ADC scaling
+    }
+    return ok;
 }
 
 
 // --- Begin Helper Functions for Value Conversion ---
 // Reads 16-bit values (MSB and LSB)
 uint16_t bq25155::readRaw16BitRegister(uint8_t msb_reg, uint8_t lsb_reg) {
-    uint8_t msb = readRegister(msb_reg);
-    uint8_t lsb = readRegister(lsb_reg);
+    uint8_t raw[2] = {0x00, 0x00};
+    if (lsb_reg == msb_reg + 1) {
+        readRegisters(msb_reg, raw, 2); // MSB/LSB from the same transaction, cannot be torn
+    } else {
+        raw[0] = readRegister(msb_reg);
+        raw[1] = readRegister(lsb_reg);
+    }
     // The ADC reports a 16-bit measurement.
-    return ((uint16_t)msb << 8) | lsb;
+    return ((uint16_t)raw[0] << 8) | raw[1];
 }
 
 
-uint16_t bq25155::KeepDecimals(uint32_t value, uint8_t digits) {
+// Full 32-bit result: IIN (up to 750000 uA) and ICHG % (up to 100000) do not fit in 16 bits.
+uint32_t bq25155::KeepDecimals(uint32_t value, uint8_t digits) {
     if (digits == 0) {
-        return (value > MAX16BIT) ? MAX16BIT : (uint16_t)value;
+        return value;
     }
 
     if (digits > 5) digits = 5;
@@ -223,75 +967,215 @@ uint16_t bq25155::KeepDecimals(uint32_t value, uint8_t digits) {
         factor *= 10;
     }
 
-    uint32_t rounded = (value / factor) * factor;
-    if (rounded > MAX16BIT) return MAX16BIT;
-
-    return (uint16_t)rounded;
+    return (value / factor) * factor;
 }
 
 
-uint16_t bq25155::GenADCVRead(uint8_t ADC_DATA_MSB, uint8_t ADC_DATA_LSB, uint8_t KeepDec, bool VRef) {
-    uint16_t ADC_Reading = readRaw16BitRegister(ADC_DATA_MSB, ADC_DATA_LSB);
+AdcConversionContext bq25155::makeAdcContext(uint8_t adcSpeed, uint8_t ilimCode) {
+    AdcConversionContext ctx;
+    ctx.valid = true;
+    ctx.adcSpeed = adcSpeed;
     // Datasheet: ADC resolution is 12-bit at 24/12 ms, 10-bit at 6/3 ms.
-    uint8_t adcSpeed = getADCConvSpeed();
-    if (adcSpeed >= 2) {
-        ADC_Reading &= 0xFFC0; // 10-bit, left aligned in 16-bit (keep top 10 bits)
-    } else {
-        ADC_Reading &= 0xFFF0; // 12-bit, left aligned in 16-bit (keep top 12 bits)
+    ctx.resolutionMask = (adcSpeed >= 2) ? 0xFFC0 : 0xFFF0; // Left aligned in 16-bit
+    ctx.ilimCode = ilimCode;
+    ctx.iinFullScale_uA = (ilimCode > 2) ? 750000UL : 375000UL;
+    return ctx;
+}
+
+// Loaded on first use; noteAdcContextWrite() keeps it in step with the configuration.
+const AdcConversionContext &bq25155::adcContext() {
+    if (!_adcCtx.valid) {
+        _adcCtx.valid = true; // Cleared by readRegisters() if either load below fails
+        const uint8_t adcSpeed = getADCConvSpeed();
+        const uint8_t ilimCode = getILIM();
+        const bool loaded = _adcCtx.valid;
+        _adcCtx = makeAdcContext(adcSpeed, ilimCode);
+        _adcCtx.valid = loaded; // A failed load is retried by the next reader
     }
-    
+    return _adcCtx;
+}
+
+AdcConversionContext bq25155::getAdcConversionContext() {
+    return adcContext();
+}
+
+void bq25155::noteAdcContextWrite(uint8_t startReg, const uint8_t *data, uint8_t len) {
+    if (!_adcCtx.valid) { return; } // Nothing cached yet
+    if (startReg <= REG_ADCCTRL0 && REG_ADCCTRL0 < startReg + len) {
+        _adcCtx = makeAdcContext((data[REG_ADCCTRL0 - startReg] & ADC_CONV_SPEED_MASK) >> 3, _adcCtx.ilimCode);
+    }
+    if (startReg <= REG_ILIMCTRL && REG_ILIMCTRL < startReg + len) {
+        _adcCtx = makeAdcContext(_adcCtx.adcSpeed, data[REG_ILIMCTRL - startReg] & ILIM_MASK);
+    }
+}
+
+
+uint16_t bq25155::convertADCVoltage(uint16_t ADC_Reading, const AdcConversionContext &ctx, uint8_t KeepDec, bool VRef) {
+    ADC_Reading &= ctx.resolutionMask;
+
     uint16_t scale = (VRef ? 6000 : 1200);
 
     uint32_t mVolts = ((uint32_t)ADC_Reading * scale) / 65536UL;
 
-    return KeepDecimals(mVolts, KeepDec);
+    return (uint16_t)KeepDecimals(mVolts, KeepDec); // <= 6000 mV
 }
 
 
-uint32_t bq25155::GenADCIRead(uint8_t ADC_DATA_MSB, uint8_t ADC_DATA_LSB, uint8_t KeepDec) {
+uint32_t bq25155::convertADCCurrent(uint16_t ADC_Reading, const AdcConversionContext &ctx, uint8_t KeepDec) {
     // Needs implementation: IIN reading only valid when VIN > VUVLO and VIN < VOVP
-    uint16_t ADC_Reading = readRaw16BitRegister(ADC_DATA_MSB, ADC_DATA_LSB);
-    // Datasheet: ADC resolution is 12-bit at 24/12 ms, 10-bit at 6/3 ms.
-    uint8_t adcSpeed = getADCConvSpeed();
-    if (adcSpeed >= 2) {
-        ADC_Reading &= 0xFFC0; // 10-bit, left aligned in 16-bit (keep top 10 bits)
-    } else {
-        ADC_Reading &= 0xFFF0; // 12-bit, left aligned in 16-bit (keep top 12 bits)
-    }
-
-    uint32_t scale = (getILIM() > 2) ? 750000UL : 375000UL;
+    ADC_Reading &= ctx.resolutionMask;
 
-    uint32_t uAmps = ((uint32_t)ADC_Reading * scale) / 65536UL;
+    uint32_t uAmps = ((uint32_t)ADC_Reading * ctx.iinFullScale_uA) / 65536UL;
 
     return KeepDecimals(uAmps, KeepDec);
 }
 
 
-uint32_t bq25155::GenADCIPRead(uint8_t ADC_DATA_MSB, uint8_t ADC_DATA_LSB, uint8_t KeepDec) {
+uint32_t bq25155::convertADCChargePercent(uint16_t ADC_Reading, const AdcConversionContext &ctx, uint8_t KeepDec) {
     // Needs implementation: Where ICHARGE is the charge current setting.
     // Note that if the device is in pre-charge or in the TS COLD region,
     // ICHARGE will be the current set by the IPRECHRG and TS_ICHRG bits respectively
-    uint16_t ADC_Reading = readRaw16BitRegister(ADC_DATA_MSB, ADC_DATA_LSB);
-    // Datasheet: ADC resolution is 12-bit at 24/12 ms, 10-bit at 6/3 ms.
-    uint8_t adcSpeed = getADCConvSpeed();
-    if (adcSpeed >= 2) {
-        ADC_Reading &= 0xFFC0; // 10-bit, left aligned in 16-bit (keep top 10 bits)
-    } else {
-        ADC_Reading &= 0xFFF0; // 12-bit, left aligned in 16-bit (keep top 12 bits)
-    }
+    ADC_Reading &= ctx.resolutionMask;
 
     // Scale: 100% / (0.8 x 65536) ~ 100000 / 52429
     // Keeps 3 implied decimal digits: 12345 > 12.345%
-    uint32_t percent_scaled = ((uint32_t)ADC_Reading * 100000UL) / 52429UL;
+    uint32_t percent_scaled = ((uint32_t)ADC_Reading * 100000UL) / ctx.ichgFullScale;
     if (percent_scaled > 100000UL) percent_scaled = 100000UL;
 
     return KeepDecimals(percent_scaled, KeepDec);
 }
 
+
+uint16_t bq25155::GenADCVRead(uint8_t ADC_DATA_MSB, uint8_t ADC_DATA_LSB, uint8_t KeepDec, bool VRef) {
+    const AdcConversionContext &ctx = adcContext();
+    uint16_t ADC_Reading = readRaw16BitRegister(ADC_DATA_MSB, ADC_DATA_LSB);
+    return convertADCVoltage(ADC_Reading, ctx, KeepDec, VRef);
+}
+
+
+uint32_t bq25155::GenADCIRead(uint8_t ADC_DATA_MSB, uint8_t ADC_DATA_LSB, uint8_t KeepDec) {
+    const AdcConversionContext &ctx = adcContext();
+    uint16_t ADC_Reading = readRaw16BitRegister(ADC_DATA_MSB, ADC_DATA_LSB);
+    return convertADCCurrent(ADC_Reading, ctx, KeepDec);
+}
+
+
+uint32_t bq25155::GenADCIPRead(uint8_t ADC_DATA_MSB, uint8_t ADC_DATA_LSB, uint8_t KeepDec) {
+    const AdcConversionContext &ctx = adcContext();
+    uint16_t ADC_Reading = readRaw16BitRegister(ADC_DATA_MSB, ADC_DATA_LSB);
+    return convertADCChargePercent(ADC_Reading, ctx, KeepDec);
+}
+
 // --- End Helper Functions for Value Conversion ---
 
 // --- STATUS Registers ---
 
+// --- Begin Status Snapshot ---
+StatusSnapshot bq25155::readStatus(bool includeFlags) {
+    BQ25155_BUS_API(READ_STATUS);
+    StatusSnapshot snap;
+    // STAT0-2 (0x00-0x02) are followed by FLAG0-3 (0x03-0x06): one auto-increment burst.
+    uint8_t regs[7] = {};
+    const uint8_t len = includeFlags ? 7 : 3;
+    if (!readRegisters(REG_STAT_0, regs, len)) {
+        return snap;
+    }
+
+    snap.valid = true;
+    snap.status = (uint32_t)regs[0] | ((uint32_t)regs[1] << 8) | ((uint32_t)regs[2] << 16);
+    if (includeFlags) {
+        snap.flagsIncluded = true;
+        // The burst cleared FLAG0-3 in hardware; keep them in the cache like readAllFLAGS().
+        cachedFlag0 = regs[3];
+        cachedFlag1 = regs[4];
+        cachedFlag2 = regs[5];
+        cachedFlag3 = regs[6];
+        snap.flags = getCachedFlags();
+        ingestFlags(snap.flags);
+        latchPGCompletionFromCachedFlags();
+    }
+
+    if (snap.chargeDone()) {
+        _pgChargeDoneLatched = true;
+    }
+    if (includeFlags || snap.chargeDone()) {
+        refreshPGIndicatorFromState();
+    }
+    return snap;
+}
+// --- End Status Snapshot ---
+
+// --- Begin Charge Status ---
+ChargeStatus bq25155::getChargeStatus() {
+    return updateChargeStatus(readStatus());
+}
+
+ChargeStatus bq25155::updateChargeStatus(const StatusSnapshot &snap) {
+    if (!snap.valid) {
+        return ChargeStatus::BQ_UNKNOWN_STATUS;
+    }
+
+    const uint32_t nowMs = millis();
+    accumulateChargePhaseTime(nowMs);
+
+    // Only the bits that decide the phase (CHARGER_DISABLE from the shadowed ICCTRL2).
+    const uint32_t key =
+        (snap.stat0() & (CHRG_CV_STAT_MASK | CHARGE_DONE_STAT_MASK | VIN_PGOOD_STAT_MASK)) |
+        ((uint32_t)(snap.stat1() & (VIN_OVP_FAULT_STAT_MASK | BAT_OCP_FAULT_STAT_MASK |
+                                    TS_COLD_STAT_MASK | TS_HOT_STAT_MASK)) << 8) |
+        ((uint32_t)(isChargeEnabled() ? 1 : 0) << 16);
+
+    const bool recheckVbat = (_chgPhase.phase == ChargeStatus::BQ_PRECHARGE) &&
+                             (uint32_t)(nowMs - _chgVbatCheckMs) >= CHARGE_PHASE_VBAT_RECHECK_MS;
+    if (key == _chgStatusKey && !recheckVbat) {
+        return _chgPhase.phase;
+    }
+    _chgStatusKey = key;
+
+    ChargeStatus phase;
+    _chgPhase.constantVoltage = false;
+    if (!snap.vinPgood() || !isChargeEnabled() || snap.chargeSuspended() ||
+        snap.vinOvp() || snap.batOcp()) {
+        phase = ChargeStatus::BQ_NOT_CHARGING;
+    } else if (snap.chargeDone()) {
+        phase = ChargeStatus::BQ_CHARGE_DONE;
+    } else if (snap.chrgCV()) {
+        phase = ChargeStatus::BQ_FASTCHARGE;
+        _chgPhase.constantVoltage = true;
+    } else {
+        const uint16_t vlowv_mV = getVLOWThrs() ? 2800 : 3000; // VLOWV_SEL: 1b1 = 2.8 V
+        _chgVbatCheckMs = nowMs;
+        phase = (readVBAT(0) < vlowv_mV) ? ChargeStatus::BQ_PRECHARGE : ChargeStatus::BQ_FASTCHARGE;
+    }
+
+    if (phase != _chgPhase.phase) {
+        _chgPhase.previousPhase = _chgPhase.phase;
+        _chgPhase.previousEnteredMs = _chgPhase.enteredMs;
+        _chgPhase.phase = phase;
+        _chgPhase.enteredMs = nowMs;
+        _chgPhase.transitions++;
+    }
+    return phase;
+}
+
+ChargePhaseStats bq25155::getChargePhaseStats() {
+    accumulateChargePhaseTime(millis());
+    return _chgPhase;
+}
+
+void bq25155::resetChargePhaseStats() {
+    _chgPhase = ChargePhaseStats();
+    _chgStatusKey = 0xFFFFFFFFUL;
+}
+
+void bq25155::accumulateChargePhaseTime(uint32_t nowMs) {
+    if (_chgPhase.transitions != 0) { // Time before the first known phase is not counted
+        _chgPhase.totalMs[static_cast<uint8_t>(_chgPhase.phase)] += (uint32_t)(nowMs - _chgLastUpdateMs);
+    }
+    _chgLastUpdateMs = nowMs;
+}
+// --- End Charge Status ---
+
 // --- Begin STAT0 Register - Charger Status ---
 bool bq25155::is_CHRG_CV() { return (readRegister(REG_STAT_0) & CHRG_CV_STAT_MASK) != 0; }
 bool bq25155::is_CHARGE_DONE() {
@@ -317,7 +1201,9 @@ bool bq25155::is_BAT_COLD() { return (readRegister(REG_STAT_1) & TS_COLD_STAT_MA
 bool bq25155::is_BAT_COOL() { return (readRegister(REG_STAT_1) & TS_COOL_STAT_MASK) != 0; }
 bool bq25155::is_BAT_WARM() { return (readRegister(REG_STAT_1) & TS_WARM_STAT_MASK) != 0; }
 bool bq25155::is_BAT_HOT() { return (readRegister(REG_STAT_1) & TS_HOT_STAT_MASK) != 0; }
-bool bq25155::is_CHG_SUSPENDED() { return (is_BAT_COLD() || is_BAT_HOT()); }
+bool bq25155::is_CHG_SUSPENDED() {
+    return (readRegister(REG_STAT_1) & (TS_COLD_STAT_MASK | TS_HOT_STAT_MASK)) != 0;
+}
 // --- End STAT1 Register - Charger Status ---
 
 // --- Begin STAT2 Register - ADC Status ---
@@ -344,27 +1230,264 @@ bool bq25155::is_TS_OPEN() { return (readRegister(REG_STAT_2) & TS_OPEN_STAT_MAS
 // --- FLAG Registers ---
 // Read FLAGs to only clear them all at once
 void bq25155::ClearAllFlags() {
-    // We just need to read to clear 'em all.
-    readRegister(REG_FLAG_0);
-    readRegister(REG_FLAG_1);
-    readRegister(REG_FLAG_2);
-    readRegister(REG_FLAG_3);
+    BQ25155_BUS_API(CLEAR_ALL_FLAGS);
+    // We just need to read to clear 'em all (FLAG0..FLAG3 are contiguous, one burst).
+    uint8_t flags[4];
+    if (readRegisters(REG_FLAG_0, flags, 4)) {
+        // Dropped from the FLAG cache, but still delivered to the accumulator consumers.
+        ingestFlags((uint32_t)flags[0] | ((uint32_t)flags[1] << 8) |
+                    ((uint32_t)flags[2] << 16) | ((uint32_t)flags[3] << 24));
+    }
 
     resetPGLatchForNewChargeCycle();
     refreshPGIndicatorFromState();
 }
 
-// Reads and caches all FLAG registers at once
+// Reads and caches all FLAG registers at once (single 4-byte burst)
 void bq25155::readAllFLAGS() {
-    cachedFlag0 = readRegister(REG_FLAG_0);
-    cachedFlag1 = readRegister(REG_FLAG_1);
-    cachedFlag2 = readRegister(REG_FLAG_2);
-    cachedFlag3 = readRegister(REG_FLAG_3);
+    BQ25155_BUS_API(READ_ALL_FLAGS);
+    uint8_t flags[4];
+    readRegisters(REG_FLAG_0, flags, 4);
+    cachedFlag0 = flags[0];
+    cachedFlag1 = flags[1];
+    cachedFlag2 = flags[2];
+    cachedFlag3 = flags[3];
+    ingestFlags(getCachedFlags());
 
     latchPGCompletionFromCachedFlags();
     refreshPGIndicatorFromState();
 }
 
+// --- Begin Interrupt Events ---
+#if defined(ESP32) || defined(ESP8266)
+#define BQ25155_ISR_ATTR IRAM_ATTR
+#else
+#define BQ25155_ISR_ATTR
+#endif
+
+bq25155 *bq25155::_isrInstance = nullptr;
+
+void BQ25155_ISR_ATTR bq25155::isrTrampoline() {
+    if (_isrInstance != nullptr) {
+        _isrInstance->_intPending = true; // Bus work happens in service(), never in the ISR
+    }
+}
+
+bool bq25155::enableInterrupt() {
+#ifdef ARDUINO
+    if (_INT_pin == 0xFF) { return false; }
+    const int irq = digitalPinToInterrupt(_INT_pin);
+    if (irq < 0) { return false; } // NOT_AN_INTERRUPT
+    _isrInstance = this;
+    _intPending = true; // Catch events latched before the ISR was attached
+    attachInterrupt(irq, isrTrampoline, FALLING);
+    return true;
+#else
+    return false; // Host builds: call markInterruptPending() from the GPIO handler
+#endif
+}
+
+void bq25155::disableInterrupt() {
+#ifdef ARDUINO
+    if (_INT_pin != 0xFF && _isrInstance == this) {
+        detachInterrupt(digitalPinToInterrupt(_INT_pin));
+        _isrInstance = nullptr;
+    }
+#endif
+}
+
+uint32_t bq25155::service(bool force) {
+    if (_resetCheckIntervalMs != 0 && (uint32_t)(millis() - _resetCheckLastMs) >= _resetCheckIntervalMs) {
+        checkForChipReset();
+    }
+    if (!_intPending && !force) {
+        serviceAdcAcquisition(); // ADC_READY taken by another FLAG read, or the fallback is due
+        serviceWatchdog();
+        return 0;
+    }
+    _intPending = false; // Cleared before the read so an INT during the burst is not lost
+
+    readAllFLAGS(); // Also feeds the watchdog
+    const uint32_t flags = getCachedFlags();
+    serviceAdcAcquisition(); // Before the callbacks, so ADC_READY handlers see the frame
+
+    for (uint8_t byteIndex = 0; byteIndex < 4; byteIndex++) {
+        uint8_t bits = (uint8_t)(flags >> (byteIndex * 8));
+        for (uint8_t b = 0; bits != 0; b++, bits >>= 1) {
+            if ((bits & 0x01) == 0) { continue; }
+            const uint8_t index = byteIndex * 8 + b;
+            if (_eventCallbacks[index] != nullptr) {
+                _eventCallbacks[index](static_cast<ChargerEvent>(index), _eventContexts[index]);
+            }
+        }
+    }
+    return flags;
+}
+
+bool bq25155::onEvent(ChargerEvent event, ChargerEventCallback callback, void *context) {
+    const uint8_t index = static_cast<uint8_t>(event);
+    if (index >= CHARGER_EVENT_COUNT) { return false; }
+    _eventCallbacks[index] = callback; // nullptr unregisters
+    _eventContexts[index] = context;
+    return true;
+}
+
+bool bq25155::setInterruptMasks(uint32_t maskedEvents) {
+    const uint8_t masks[4] = {
+        (uint8_t)(maskedEvents),
+        (uint8_t)(maskedEvents >> 8),
+        (uint8_t)(maskedEvents >> 16),
+        (uint8_t)(maskedEvents >> 24)
+    };
+    return writeRegisters(REG_MASK_0, masks, 4);
+}
+
+uint32_t bq25155::getInterruptMasks() {
+    uint8_t masks[4];
+#if BQ25155_USE_SHADOW
+    BusSession session(*this);
+    for (uint8_t i = 0; i < 4; i++) { masks[i] = readRegister(REG_MASK_0 + i); } // Shadowed
+#else
+    readRegisters(REG_MASK_0, masks, 4);
+#endif
+    return (uint32_t)masks[0] | ((uint32_t)masks[1] << 8) |
+           ((uint32_t)masks[2] << 16) | ((uint32_t)masks[3] << 24);
+}
+
+uint32_t bq25155::getCachedFlags() const {
+    return (uint32_t)cachedFlag0 | ((uint32_t)cachedFlag1 << 8) |
+           ((uint32_t)cachedFlag2 << 16) | ((uint32_t)cachedFlag3 << 24);
+}
+// --- End Interrupt Events ---
+
+// --- Begin Chip Reset Detection ---
+bool bq25155::checkForChipReset() {
+    _resetCheckLastMs = millis();
+#if BQ25155_USE_SHADOW
+    if (_stageDepth != 0 || _chargeReconfigDepth != 0) { return false; } // Shadow is mid-update
+
+    for (uint8_t i = 0; i < RESET_SENTINEL_CANDIDATE_COUNT; i++) {
+        const RegisterDefault &candidate = RESET_SENTINEL_CANDIDATES[i];
+        const uint8_t idx = shadowIndex(candidate.reg);
+        if ((_shadowValid & (1UL << idx)) == 0 || _shadow[idx] == candidate.value) { continue; }
+
+        // First configured register away from its default: it is back there only after a reset.
+        BusSession session(*this); // Sentinel and restore share one LPM window
+        uint8_t value = 0;
+        if (!readRegisters(candidate.reg, &value, 1) || value == _shadow[idx]) { return false; }
+        if (value != candidate.value) {
+            // Changed, but not to its default (another bus master, a corrupted read): not a
+            // reset. Follow the device instead of rewriting the whole configuration.
+            updateShadow(candidate.reg, value);
+            return false;
+        }
+        if (_chipResetCount < 0xFFFF) { _chipResetCount++; }
+        restoreConfigImage();
+        return true;
+    }
+#endif
+    return false;
+}
+
+void bq25155::setResetCheckInterval(uint32_t intervalMs) {
+    _resetCheckIntervalMs = intervalMs;
+    _resetCheckLastMs = millis();
+}
+
+uint16_t bq25155::getChipResetCount() const {
+    return _chipResetCount;
+}
+// --- End Chip Reset Detection ---
+
+// --- Begin Watchdog Keeper ---
+bool bq25155::enableWatchdogKeeper(uint32_t marginMs) {
+    _wdKeeper = WatchdogKeeperStats();
+    uint32_t timeoutMs = 0;
+    if (isRST14sWDEnabled()) {
+        timeoutMs = HWRESET_WD_TIMEOUT_MS;
+    } else if (isWatchdogTEnabled()) {
+        timeoutMs = I2C_WATCHDOG_TIMEOUT_MS;
+    }
+    if (timeoutMs == 0 || marginMs >= timeoutMs) { return false; }
+
+    _wdKeeperMarginMs = marginMs;
+    _wdKeeper.lastActivityMs = millis(); // The reads above just fed it
+    _wdKeeper.minMarginMs = (int32_t)timeoutMs;
+    _wdKeeper.timeoutMs = timeoutMs;
+    return true;
+}
+
+void bq25155::disableWatchdogKeeper() {
+    _wdKeeper.timeoutMs = 0;
+}
+
+bool bq25155::serviceWatchdog() {
+    if (_wdKeeper.timeoutMs == 0 || msUntilKeepAlive() != 0) { return false; }
+    uint8_t stat0 = 0;
+    // No side effects; any transaction resets the timer. A failed one is retried next call.
+    if (!readRegisters(REG_STAT_0, &stat0, 1)) { return false; }
+    _wdKeeper.keepAlives++;
+    return true;
+}
+
+uint32_t bq25155::msUntilKeepAlive() const {
+    if (_wdKeeper.timeoutMs == 0) { return 0xFFFFFFFFUL; }
+    const uint32_t idle = millis() - _wdKeeper.lastActivityMs;
+    const uint32_t due = _wdKeeper.timeoutMs - _wdKeeperMarginMs;
+    return (idle >= due) ? 0 : due - idle;
+}
+
+WatchdogKeeperStats bq25155::getWatchdogKeeperStats() const {
+    return _wdKeeper;
+}
+// --- End Watchdog Keeper ---
+
+// --- Begin FLAG Accumulator ---
+void bq25155::ingestFlags(uint32_t flags) {
+    if (flags == 0) { return; }
+    _flagSticky |= flags;
+    if (_adcAcqPending && (flags & eventBit(ChargerEvent::ADC_READY)) != 0) {
+        _adcAcqFlagSeen = true; // Kept for service() even if the caller was not service()
+    }
+    for (uint8_t i = 0; i < BQ25155_MAX_FLAG_CONSUMERS; i++) {
+        if ((_flagConsumers & (1U << i)) != 0) { _flagPending[i] |= flags; }
+    }
+}
+
+int8_t bq25155::registerFlagConsumer() {
+    for (uint8_t i = 0; i < BQ25155_MAX_FLAG_CONSUMERS; i++) {
+        if ((_flagConsumers & (1U << i)) == 0) {
+            _flagConsumers |= (uint8_t)(1U << i);
+            _flagPending[i] = 0; // Only events read from now on
+            return (int8_t)i;
+        }
+    }
+    return -1;
+}
+
+void bq25155::unregisterFlagConsumer(uint8_t consumer) {
+    if (consumer >= BQ25155_MAX_FLAG_CONSUMERS) { return; }
+    _flagConsumers &= (uint8_t)~(1U << consumer);
+    _flagPending[consumer] = 0;
+}
+
+uint32_t bq25155::peekFlags(uint8_t consumer) const {
+    return (consumer < BQ25155_MAX_FLAG_CONSUMERS) ? _flagPending[consumer] : 0;
+}
+
+uint32_t bq25155::fetchFlags(uint8_t consumer, uint32_t mask) {
+    if (consumer >= BQ25155_MAX_FLAG_CONSUMERS) { return 0; }
+    const uint32_t events = _flagPending[consumer] & mask;
+    _flagPending[consumer] &= ~mask;
+    return events;
+}
+
+void bq25155::ackFlags(uint8_t consumer, uint32_t mask) {
+    if (consumer >= BQ25155_MAX_FLAG_CONSUMERS) { return; }
+    _flagPending[consumer] &= ~mask;
+}
+// --- End FLAG Accumulator ---
+
 // Count how many flags are triggered per FLAG register.
 void bq25155::FaultsDetected(uint8_t* faultsOut) {
     uint8_t faultsReg[4] = {
@@ -412,37 +1535,32 @@ void bq25155::resetFaultAutoDisableFilterState() {
     _faultClearCounter = 0;
 }
 
+void bq25155::setSevereFaultMasks(const FaultMaskTable &masks) {
+    _severeFaults = masks;
+}
+
+FaultMaskTable bq25155::getSevereFaultMasks() const {
+    return _severeFaults;
+}
+
 bool bq25155::enforceSafetyFaultPolicy(bool *chargeDisabled, bool refreshFlags) {
+    BQ25155_BUS_API(ENFORCE_SAFETY_FAULT_POLICY);
+    BusSession session(*this);
     if (chargeDisabled != nullptr) {
         *chargeDisabled = false;
     }
 
-    if (refreshFlags) {
-        readAllFLAGS();
+    // STAT0-2, plus FLAG0-3 when refreshing, in a single burst. readStatus() latches the PG
+    // completion and refreshes the indicator from the FLAGs it read.
+    const StatusSnapshot snap = readStatus(refreshFlags);
+    if (!snap.valid) {
+        return false; // A failed read is not a clear sample
     }
-    latchPGCompletionFromCachedFlags();
-    refreshPGIndicatorFromState();
 
-    const bool severeFlagFault =
-        VIN_OVP_Flag() ||
-        BAT_OCP_Flag() ||
-        BAT_UVLO_Flag() ||
-        TS_COLD_Flag() ||
-        TS_HOT_Flag() ||
-        VTS_OPEN_Flag() ||
-        WD_FAULT_Flag() ||
-        SAFETY_TMR_Flag() ||
-        LDO_OCP_Flag();
-
-    const bool severeStatusFault =
-        is_VIN_OVP_TRIG() ||
-        is_BAT_OCP_TRIG() ||
-        is_BAT_UVLO() ||
-        is_BAT_COLD() ||
-        is_BAT_HOT() ||
-        is_TS_OPEN();
-
-    const bool severeFault = severeFlagFault || severeStatusFault;
+    // FLAG bits only count when this call read them; older cached FLAGs were already acted on.
+    const bool severeFault =
+        (snap.status & _severeFaults.status) != 0 ||
+        (snap.flags & _severeFaults.flags) != 0;
 
     if (!severeFault) {
         if (_faultClearCounter < _faultClearThreshold) {
@@ -471,10 +1589,259 @@ bool bq25155::enforceSafetyFaultPolicy(bool *chargeDisabled, bool refreshFlags)
     return DisableCharge();
 }
 
+// --- Begin Fault Rules ---
+static uint8_t lowestSetBit(uint32_t bits) {
+    return (uint8_t)__builtin_ctzl((unsigned long)bits);
+}
+
+int8_t bq25155::addFaultRule(const FaultRule &rule) {
+    const uint8_t bit = static_cast<uint8_t>(rule.condition);
+    const uint8_t src = static_cast<uint8_t>(rule.source);
+    if (bit >= CHARGER_EVENT_COUNT || src > 1 || rule.tripSamples == 0 || rule.clearSamples == 0 ||
+        static_cast<uint8_t>(rule.action) >= FAULT_ACTION_COUNT) {
+        return -1;
+    }
+    if (rule.action == FaultAction::SCALE_CHARGE_CURRENT && (rule.param == 0 || rule.param > 100)) {
+        return -1;
+    }
+    if (rule.action == FaultAction::DROP_ILIM && rule.param > ILIM_600MA) {
+        return -1;
+    }
+
+    uint8_t index = _faultRuleByBit[src][bit];
+    if (index != 0) {
+        index--; // Replace the existing rule for this condition
+        if ((_faultRuleActive & (1UL << index)) != 0) {
+            // Release the old action before the slot changes meaning.
+            const FaultAction oldAction = _faultRules[index].action;
+            _faultRuleActive &= ~(1UL << index);
+            applyFaultAction(oldAction);
+        }
+    } else {
+        if (_faultRuleCount >= BQ25155_MAX_FAULT_RULES) {
+            return -1;
+        }
+        index = _faultRuleCount++;
+        _faultRuleByBit[src][bit] = index + 1;
+        _faultRuleWatch[src] |= (1UL << bit);
+    }
+
+    _faultRules[index] = rule;
+    _faultRuleTripCount[index] = 0;
+    _faultRuleClearCount[index] = 0;
+    _faultRuleTrips[index] = 0;
+    _faultRuleTracking &= ~(1UL << index);
+    return (int8_t)index;
+}
+
+bool bq25155::clearFaultRules() {
+    BusSession session(*this);
+    bool ok = true;
+    const uint32_t wasActive = _faultRuleActive;
+    _faultRuleActive = 0;
+    for (uint8_t a = 0; a < FAULT_ACTION_COUNT; a++) {
+        if ((_faultActionHeld & (1U << a)) != 0) {
+            ok = applyFaultAction(static_cast<FaultAction>(a)) && ok;
+        }
+    }
+    if (_faultRuleCallback != nullptr) {
+        for (uint32_t bits = wasActive; bits != 0; bits &= bits - 1) {
+            const uint8_t i = lowestSetBit(bits);
+            if (_faultRules[i].action == FaultAction::CALLBACK) {
+                _faultRuleCallback(i, false, _faultRuleContext);
+            }
+        }
+    }
+
+    for (uint8_t src = 0; src < 2; src++) {
+        for (uint8_t b = 0; b < CHARGER_EVENT_COUNT; b++) { _faultRuleByBit[src][b] = 0; }
+        _faultRuleWatch[src] = 0;
+    }
+    _faultRuleCount = 0;
+    _faultRuleTracking = 0;
+    return ok;
+}
+
+void bq25155::onFaultRule(FaultRuleCallback callback, void *context) {
+    _faultRuleCallback = callback;
+    _faultRuleContext = context;
+}
+
+uint16_t bq25155::getFaultRuleTrips(uint8_t index) const {
+    return (index < _faultRuleCount) ? _faultRuleTrips[index] : 0;
+}
+
+uint32_t bq25155::evaluateFaultRules(bool refreshFlags) {
+    BQ25155_BUS_API(EVALUATE_FAULT_RULES);
+    if (_faultRuleCount == 0) {
+        return 0;
+    }
+
+    BusSession session(*this);
+    const StatusSnapshot snap = readStatus(refreshFlags);
+    if (!snap.valid) {
+        return _faultRuleActive; // A failed read is not a clear sample
+    }
+
+    // Rules whose condition is present in this sample: one lookup per set, watched bit.
+    uint32_t present = 0;
+    // FLAGs only count when this call read them: a latched value from an older read would
+    // look present on every later sample and never clear.
+    const uint32_t sample[2] = { snap.status, snap.flagsIncluded ? snap.flags : 0 };
+    for (uint8_t src = 0; src < 2; src++) {
+        for (uint32_t bits = sample[src] & _faultRuleWatch[src]; bits != 0; bits &= bits - 1) {
+            present |= 1UL << (_faultRuleByBit[src][lowestSetBit(bits)] - 1);
+        }
+    }
+
+    // Only present, active and still-counting rules need work.
+    uint8_t changedActions = 0;
+    uint32_t changedRules = 0;
+    for (uint32_t work = present | _faultRuleActive | _faultRuleTracking; work != 0; work &= work - 1) {
+        const uint8_t i = lowestSetBit(work);
+        const uint32_t bit = 1UL << i;
+        const FaultRule &rule = _faultRules[i];
+
+        if ((present & bit) != 0) {
+            _faultRuleClearCount[i] = 0;
+            if ((_faultRuleActive & bit) != 0) {
+                continue;
+            }
+            if (_faultRuleTripCount[i] < rule.tripSamples) { _faultRuleTripCount[i]++; }
+            _faultRuleTracking |= bit;
+            if (_faultRuleTripCount[i] >= rule.tripSamples) {
+                _faultRuleActive |= bit;
+                _faultRuleTracking &= ~bit;
+                if (_faultRuleTrips[i] < 0xFFFF) { _faultRuleTrips[i]++; }
+                changedActions |= (1U << static_cast<uint8_t>(rule.action));
+                changedRules |= bit;
+            }
+        } else {
+            _faultRuleTripCount[i] = 0;
+            if ((_faultRuleActive & bit) == 0) {
+                _faultRuleTracking &= ~bit; // Sub-threshold fault went away
+                continue;
+            }
+            if (_faultRuleClearCount[i] < rule.clearSamples) { _faultRuleClearCount[i]++; }
+            if (_faultRuleClearCount[i] >= rule.clearSamples) {
+                _faultRuleActive &= ~bit;
+                _faultRuleClearCount[i] = 0;
+                changedActions |= (1U << static_cast<uint8_t>(rule.action));
+                changedRules |= bit;
+            }
+        }
+    }
+
+    for (uint8_t a = 0; changedActions != 0; a++, changedActions >>= 1) {
+        if ((changedActions & 1U) != 0) {
+            applyFaultAction(static_cast<FaultAction>(a));
+        }
+    }
+
+    if (_faultRuleCallback != nullptr) {
+        for (uint32_t bits = changedRules; bits != 0; bits &= bits - 1) {
+            const uint8_t i = lowestSetBit(bits);
+            if (_faultRules[i].action == FaultAction::CALLBACK) {
+                _faultRuleCallback(i, (_faultRuleActive & (1UL << i)) != 0, _faultRuleContext);
+            }
+        }
+    }
+    return _faultRuleActive;
+}
+
+// Brings one action in line with the active rules: applies the most restrictive parameter
+// while any rule asks for it, restores the value saved on first use once none does.
+bool bq25155::applyFaultAction(FaultAction action) {
+    const uint8_t heldBit = (uint8_t)(1U << static_cast<uint8_t>(action));
+    bool wanted = false;
+    uint16_t param = 0;
+    for (uint32_t bits = _faultRuleActive; bits != 0; bits &= bits - 1) {
+        const FaultRule &rule = _faultRules[lowestSetBit(bits)];
+        if (rule.action != action) { continue; }
+        if (!wanted) {
+            param = rule.param;
+        } else if (action == FaultAction::REDUCE_VBAT) {
+            if (rule.param > param) { param = rule.param; }
+        } else if (rule.param < param) {
+            param = rule.param;
+        }
+        wanted = true;
+    }
+
+    const bool held = (_faultActionHeld & heldBit) != 0;
+    if (!wanted && !held) {
+        return true;
+    }
+
+    switch (action) {
+        case FaultAction::DISABLE_CHARGE:
+            if (wanted) {
+                if (!held) {
+                    _faultChargeWasEnabled = isChargeEnabled();
+                    _faultActionHeld |= heldBit;
+                }
+                return !isChargeEnabled() || DisableCharge();
+            }
+            _faultActionHeld &= ~heldBit;
+            return _faultChargeWasEnabled ? EnableCharge() : true;
+
+        case FaultAction::SCALE_CHARGE_CURRENT:
+            if (wanted) {
+                if (!held) {
+                    _faultBaseChargeCurrent_uA = getChargeCurrent();
+                    _faultActionHeld |= heldBit;
+                }
+                return setChargeCurrent(_faultBaseChargeCurrent_uA * param / 100UL);
+            }
+            _faultActionHeld &= ~heldBit;
+            return setChargeCurrent(_faultBaseChargeCurrent_uA);
+
+        case FaultAction::DROP_ILIM:
+            if (wanted) {
+                if (!held) {
+                    _faultBaseIlim = getILIM();
+                    _faultIlimChargeCurrent_uA = getChargeCurrent();
+                    _faultActionHeld |= heldBit;
+                }
+                return setILIM((uint8_t)((param < _faultBaseIlim) ? param : _faultBaseIlim));
+            } else {
+                _faultActionHeld &= ~heldBit;
+                // setILIM() clamped ICHG below the lower limit: put the charge current back too.
+                bool ok = setILIM(_faultBaseIlim);
+                if ((_faultActionHeld & (1U << static_cast<uint8_t>(FaultAction::SCALE_CHARGE_CURRENT))) != 0) {
+                    _faultBaseChargeCurrent_uA = _faultIlimChargeCurrent_uA;
+                    ok = applyFaultAction(FaultAction::SCALE_CHARGE_CURRENT) && ok;
+                } else {
+                    ok = setChargeCurrent(_faultIlimChargeCurrent_uA) && ok;
+                }
+                return ok;
+            }
+
+        case FaultAction::REDUCE_VBAT:
+            if (wanted) {
+                if (!held) {
+                    _faultBaseVbatReduction_mV =
+                        (uint16_t)(((readRegister(REG_TS_FASTCHGCTRL) & TS_VBAT_REG_MASK) >> 4) * 50);
+                    _faultActionHeld |= heldBit;
+                }
+                return setTSVCHG((param > _faultBaseVbatReduction_mV) ? param : _faultBaseVbatReduction_mV);
+            }
+            _faultActionHeld &= ~heldBit;
+            return setTSVCHG(_faultBaseVbatReduction_mV);
+
+        case FaultAction::LOG_ONLY:
+        case FaultAction::CALLBACK:
+        default:
+            return true;
+    }
+}
+// --- End Fault Rules ---
+
 // --- Begin FLAG0 Register - Charger Status ---
 // Once FLAG0 is readed, its values are cleared.
 uint8_t bq25155::readFLAG0() {
     cachedFlag0 = readRegister(REG_FLAG_0);
+    ingestFlags(cachedFlag0);
     latchPGCompletionFromCachedFlags();
     refreshPGIndicatorFromState();
     return cachedFlag0;
@@ -503,6 +1870,7 @@ bool bq25155::VIN_PGOOD_Flag() { return (cachedFlag0 & VIN_PGOOD_FLAG_MASK) != 0
 // Once FLAG1 is readed, its values are cleared.
 uint8_t bq25155::readFLAG1() {
     cachedFlag1 = readRegister(REG_FLAG_1);
+    ingestFlags((uint32_t)cachedFlag1 << 8);
     return cachedFlag1;
 }
 
@@ -530,6 +1898,7 @@ bool bq25155::TS_HOT_Flag() { return (cachedFlag1 & TS_HOT_FLAG_MASK) != 0; }
 // Once FLAG2 is readed, its values are cleared.
 uint8_t bq25155::readFLAG2() {
     cachedFlag2 = readRegister(REG_FLAG_2);
+    ingestFlags((uint32_t)cachedFlag2 << 16);
     return cachedFlag2;
 }
 
@@ -553,6 +1922,7 @@ bool bq25155::VTS_OPEN_Flag() { return (cachedFlag2 & TS_OPEN_FLAG_MASK) != 0; }
 // Once FLAG3 is readed, its values are cleared.
 uint8_t bq25155::readFLAG3() {
     cachedFlag3 = readRegister(REG_FLAG_3);
+    ingestFlags((uint32_t)cachedFlag3 << 24);
     latchPGCompletionFromCachedFlags();
     refreshPGIndicatorFromState();
     return cachedFlag3;
@@ -580,42 +1950,49 @@ bool bq25155::MRST_WARN_Flag() { return (cachedFlag3 & MRRESET_WARN_FLAG_MASK) !
 // 1b0 = Interrupt Not Masked, 1b1 = Interrupt Masked
 bool bq25155::get_CHRG_CV_MASK() { return (readRegister(REG_MASK_0) & CHRG_CV_MASK) != 0; }
 bool bq25155::set_CHRG_CV_MASK(bool m) {
+    BQ25155_BUS_API(SET_INT_MASK);
     uint8_t r = readRegister(REG_MASK_0); r = m ? (r | CHRG_CV_MASK) : (r & ~CHRG_CV_MASK);
     return writeRegister(REG_MASK_0, r);
 }
 
 bool bq25155::get_CHARGE_DONE_MASK() { return (readRegister(REG_MASK_0) & CHARGE_DONE_MASK) != 0; }
 bool bq25155::set_CHARGE_DONE_MASK(bool m) {
+    BQ25155_BUS_API(SET_INT_MASK);
     uint8_t r = readRegister(REG_MASK_0); r = m ? (r | CHARGE_DONE_MASK) : (r & ~CHARGE_DONE_MASK);
     return writeRegister(REG_MASK_0, r);
 }
 
 bool bq25155::get_IINLIM_ACTIVE_MASK() { return (readRegister(REG_MASK_0) & IINLIM_ACTIVE_MASK) != 0; }
 bool bq25155::set_IINLIM_ACTIVE_MASK(bool m) {
+    BQ25155_BUS_API(SET_INT_MASK);
     uint8_t r = readRegister(REG_MASK_0); r = m ? (r | IINLIM_ACTIVE_MASK) : (r & ~IINLIM_ACTIVE_MASK);
     return writeRegister(REG_MASK_0, r);
 }
 
 bool bq25155::get_VDPPM_ACTIVE_MASK() { return (readRegister(REG_MASK_0) & VDPPM_ACTIVE_MASK) != 0; }
 bool bq25155::set_VDPPM_ACTIVE_MASK(bool m) {
+    BQ25155_BUS_API(SET_INT_MASK);
     uint8_t r = readRegister(REG_MASK_0); r = m ? (r | VDPPM_ACTIVE_MASK) : (r & ~VDPPM_ACTIVE_MASK);
     return writeRegister(REG_MASK_0, r);
 }
 
 bool bq25155::get_VINDPM_ACTIVE_MASK() { return (readRegister(REG_MASK_0) & VINDPM_ACTIVE_MASK) != 0; }
 bool bq25155::set_VINDPM_ACTIVE_MASK(bool m) {
+    BQ25155_BUS_API(SET_INT_MASK);
     uint8_t r = readRegister(REG_MASK_0); r = m ? (r | VINDPM_ACTIVE_MASK) : (r & ~VINDPM_ACTIVE_MASK);
     return writeRegister(REG_MASK_0, r);
 }
 
 bool bq25155::get_THERMREG_ACTIVE_MASK() { return (readRegister(REG_MASK_0) & THERMREG_ACTIVE_MASK) != 0; }
 bool bq25155::set_THERMREG_ACTIVE_MASK(bool m) {
+    BQ25155_BUS_API(SET_INT_MASK);
     uint8_t r = readRegister(REG_MASK_0); r = m ? (r | THERMREG_ACTIVE_MASK) : (r & ~THERMREG_ACTIVE_MASK);
     return writeRegister(REG_MASK_0, r);
 }
 
 bool bq25155::get_VIN_PGOOD_MASK() { return (readRegister(REG_MASK_0) & VIN_PGOOD_MASK) != 0; }
 bool bq25155::set_VIN_PGOOD_MASK(bool m) {
+    BQ25155_BUS_API(SET_INT_MASK);
     uint8_t r = readRegister(REG_MASK_0); r = m ? (r | VIN_PGOOD_MASK) : (r & ~VIN_PGOOD_MASK);
     return writeRegister(REG_MASK_0, r);
 }
@@ -625,42 +2002,49 @@ bool bq25155::set_VIN_PGOOD_MASK(bool m) {
 // 1b0 = Interrupt Not Masked, 1b1 = Interrupt Masked
 bool bq25155::get_VIN_OVP_FAULT_MASK() { return (readRegister(REG_MASK_1) & VIN_OVP_FAULT_MASK) != 0; }
 bool bq25155::set_VIN_OVP_FAULT_MASK(bool m) {
+    BQ25155_BUS_API(SET_INT_MASK);
     uint8_t r = readRegister(REG_MASK_1); r = m ? (r | VIN_OVP_FAULT_MASK) : (r & ~VIN_OVP_FAULT_MASK);
     return writeRegister(REG_MASK_1, r);
 }
 
 bool bq25155::get_BAT_OCP_FAULT_MASK() { return (readRegister(REG_MASK_1) & BAT_OCP_FAULT_MASK) != 0; }
 bool bq25155::set_BAT_OCP_FAULT_MASK(bool m){
+    BQ25155_BUS_API(SET_INT_MASK);
     uint8_t r = readRegister(REG_MASK_1); r = m ? (r | BAT_OCP_FAULT_MASK) : (r & ~BAT_OCP_FAULT_MASK);
     return writeRegister(REG_MASK_1, r);
 }
 
 bool bq25155::get_BAT_UVLO_FAULT_MASK() { return (readRegister(REG_MASK_1) & BAT_UVLO_FAULT_MASK) != 0; }
 bool bq25155::set_BAT_UVLO_FAULT_MASK(bool m){
+    BQ25155_BUS_API(SET_INT_MASK);
     uint8_t r = readRegister(REG_MASK_1); r = m ? (r | BAT_UVLO_FAULT_MASK) : (r & ~BAT_UVLO_FAULT_MASK);
     return writeRegister(REG_MASK_1, r);
 }
 
 bool bq25155::get_TS_COLD_MASK() { return (readRegister(REG_MASK_1) & TS_COLD_MASK) != 0; }
 bool bq25155::set_TS_COLD_MASK(bool m) {
+    BQ25155_BUS_API(SET_INT_MASK);
     uint8_t r = readRegister(REG_MASK_1); r = m ? (r | TS_COLD_MASK) : (r & ~TS_COLD_MASK);
     return writeRegister(REG_MASK_1, r);
 }
 
 bool bq25155::get_TS_COOL_MASK() { return (readRegister(REG_MASK_1) & TS_COOL_MASK) != 0; }
 bool bq25155::set_TS_COOL_MASK(bool m) {
+    BQ25155_BUS_API(SET_INT_MASK);
     uint8_t r = readRegister(REG_MASK_1); r = m ? (r | TS_COOL_MASK) : (r & ~TS_COOL_MASK);
     return writeRegister(REG_MASK_1, r);
 }
 
 bool bq25155::get_TS_WARM_MASK() { return (readRegister(REG_MASK_1) & TS_WARM_MASK) != 0; }
 bool bq25155::set_TS_WARM_MASK(bool m) {
+    BQ25155_BUS_API(SET_INT_MASK);
     uint8_t r = readRegister(REG_MASK_1); r = m ? (r | TS_WARM_MASK) : (r & ~TS_WARM_MASK);
     return writeRegister(REG_MASK_1, r);
 }
 
 bool bq25155::get_TS_HOT_MASK() { return (readRegister(REG_MASK_1) & TS_HOT_MASK) != 0; }
 bool bq25155::set_TS_HOT_MASK(bool m) {
+    BQ25155_BUS_API(SET_INT_MASK);
     uint8_t r = readRegister(REG_MASK_1); r = m ? (r | TS_HOT_MASK) : (r & ~TS_HOT_MASK);
     return writeRegister(REG_MASK_1, r);
 }
@@ -670,30 +2054,35 @@ bool bq25155::set_TS_HOT_MASK(bool m) {
 // 1b0 = Interrupt Not Masked, 1b1 = Interrupt Masked
 bool bq25155::get_ADC_READY_MASK() { return (readRegister(REG_MASK_2) & ADC_READY_MASK) != 0; }
 bool bq25155::set_ADC_READY_MASK(bool m) {
+    BQ25155_BUS_API(SET_INT_MASK);
     uint8_t r = readRegister(REG_MASK_2); r = m ? (r | ADC_READY_MASK) : (r & ~ADC_READY_MASK);
     return writeRegister(REG_MASK_2, r);
 }
 
 bool bq25155::get_COMP1_ALARM_MASK() { return (readRegister(REG_MASK_2) & COMP1_ALARM_MASK) != 0; }
 bool bq25155::set_COMP1_ALARM_MASK(bool m) {
+    BQ25155_BUS_API(SET_INT_MASK);
     uint8_t r = readRegister(REG_MASK_2); r = m ? (r | COMP1_ALARM_MASK) : (r & ~COMP1_ALARM_MASK);
     return writeRegister(REG_MASK_2, r);
 }
 
 bool bq25155::get_COMP2_ALARM_MASK() { return (readRegister(REG_MASK_2) & COMP2_ALARM_MASK) != 0; }
 bool bq25155::set_COMP2_ALARM_MASK(bool m) {
+    BQ25155_BUS_API(SET_INT_MASK);
     uint8_t r = readRegister(REG_MASK_2); r = m ? (r | COMP2_ALARM_MASK) : (r & ~COMP2_ALARM_MASK);
     return writeRegister(REG_MASK_2, r);
 }
 
 bool bq25155::get_COMP3_ALARM_MASK() { return (readRegister(REG_MASK_2) & COMP3_ALARM_MASK) != 0; }
 bool bq25155::set_COMP3_ALARM_MASK(bool m) {
+    BQ25155_BUS_API(SET_INT_MASK);
     uint8_t r = readRegister(REG_MASK_2); r = m ? (r | COMP3_ALARM_MASK) : (r & ~COMP3_ALARM_MASK);
     return writeRegister(REG_MASK_2, r);
 }
 
 bool bq25155::get_TS_OPEN_MASK() { return (readRegister(REG_MASK_2) & TS_OPEN_MASK) != 0; }
 bool bq25155::set_TS_OPEN_MASK(bool m) {
+    BQ25155_BUS_API(SET_INT_MASK);
     uint8_t r = readRegister(REG_MASK_2); r = m ? (r | TS_OPEN_MASK) : (r & ~TS_OPEN_MASK);
     return writeRegister(REG_MASK_2, r);
 }
@@ -703,36 +2092,42 @@ bool bq25155::set_TS_OPEN_MASK(bool m) {
 // 1b0 = Interrupt Not Masked, 1b1 = Interrupt Masked
 bool bq25155::get_WD_FAULT_MASK() { return (readRegister(REG_MASK_3) & WD_FAULT_MASK) != 0; }
 bool bq25155::set_WD_FAULT_MASK(bool m) {
+    BQ25155_BUS_API(SET_INT_MASK);
     uint8_t r = readRegister(REG_MASK_3); r = m ? (r | WD_FAULT_MASK) : (r & ~WD_FAULT_MASK);
     return writeRegister(REG_MASK_3, r);
 }
 
 bool bq25155::get_SAFETY_TMR_FAULT_MASK() { return (readRegister(REG_MASK_3) & SAFETY_TMR_FAULT_MASK) != 0; }
 bool bq25155::set_SAFETY_TMR_FAULT_MASK(bool m) {
+    BQ25155_BUS_API(SET_INT_MASK);
     uint8_t r = readRegister(REG_MASK_3); r = m ? (r | SAFETY_TMR_FAULT_MASK) : (r & ~SAFETY_TMR_FAULT_MASK);
     return writeRegister(REG_MASK_3, r);
 }
 
 bool bq25155::get_LDO_OCP_FAULT_MASK() { return (readRegister(REG_MASK_3) & LDO_OCP_FAULT_MASK) != 0; }
 bool bq25155::set_LDO_OCP_FAULT_MASK(bool m) {
+    BQ25155_BUS_API(SET_INT_MASK);
     uint8_t r = readRegister(REG_MASK_3); r = m ? (r | LDO_OCP_FAULT_MASK) : (r & ~LDO_OCP_FAULT_MASK);
     return writeRegister(REG_MASK_3, r);
 }
 
 bool bq25155::get_MRWAKE1_TIMEOUT_MASK() { return (readRegister(REG_MASK_3) & MRWAKE1_TIMEOUT_MASK) != 0; }
 bool bq25155::set_MRWAKE1_TIMEOUT_MASK(bool m) {
+    BQ25155_BUS_API(SET_INT_MASK);
     uint8_t r = readRegister(REG_MASK_3); r = m ? (r | MRWAKE1_TIMEOUT_MASK) : (r & ~MRWAKE1_TIMEOUT_MASK);
     return writeRegister(REG_MASK_3, r);
 }
 
 bool bq25155::get_MRWAKE2_TIMEOUT_MASK() { return (readRegister(REG_MASK_3) & MRWAKE2_TIMEOUT_MASK) != 0; }
 bool bq25155::set_MRWAKE2_TIMEOUT_MASK(bool m) {
+    BQ25155_BUS_API(SET_INT_MASK);
     uint8_t r = readRegister(REG_MASK_3); r = m ? (r | MRWAKE2_TIMEOUT_MASK) : (r & ~MRWAKE2_TIMEOUT_MASK);
     return writeRegister(REG_MASK_3, r);
 }
 
 bool bq25155::get_MRRESET_WARN_MASK() { return (readRegister(REG_MASK_3) & MRRESET_WARN_MASK) != 0; }
 bool bq25155::set_MRRESET_WARN_MASK(bool m) {
+    BQ25155_BUS_API(SET_INT_MASK);
     uint8_t r = readRegister(REG_MASK_3); r = m ? (r | MRRESET_WARN_MASK) : (r & ~MRRESET_WARN_MASK);
     return writeRegister(REG_MASK_3, r);
 }
@@ -751,16 +2146,11 @@ uint16_t bq25155::getChargeVoltage() {
 }
 
 bool bq25155::setChargeVoltage(uint16_t target_mV) {
+    BQ25155_BUS_API(SET_CHARGE_VOLTAGE);
     if (!enterChargeReconfig()) { return false; }
 
-    if (target_mV < 3600) { target_mV = 3600; }
-    uint16_t chemistryMax_mV = getChemistryMaxChargeVoltage_mV();
-    if (target_mV > chemistryMax_mV) { target_mV = chemistryMax_mV; }
-
-    // Calculate new VBAT_REG value
-    uint8_t vbat_bits = (target_mV - 3600) / 10; // VBATREG = 3.6 V + vbat_bits x 10 mV
-    // If a value greater than 4.6 V is written, keep 4.6 V (datasheet Vmax)
-    if (vbat_bits > 100) { vbat_bits = 100; }
+    // VBATREG = 3.6 V + vbat_bits x 10 mV, within [3.6 V, chemistry max] and 4.6 V (datasheet Vmax)
+    const uint8_t vbat_bits = vbatRegCode(target_mV, _batteryChemistry);
 
     uint8_t VBATREG = readRegister(REG_VBAT_CTRL); // Read VBAT_CTRL
 
@@ -773,8 +2163,12 @@ bool bq25155::setChargeVoltage(uint16_t target_mV) {
 // --- End VBAT charging Register ---
 
 // --- Begin Fast Charge Settings ---
-bool bq25155::isFastChargeEnabled() { return (readRegister(REG_PCHRGCTRL) & ICHARGE_RANGE_MASK) != 0; }
+bool bq25155::isFastChargeEnabled() {
+    BQ25155_BUS_API(IS_FAST_CHARGE_ENABLED);
+    return (readRegister(REG_PCHRGCTRL) & ICHARGE_RANGE_MASK) != 0;
+}
 bool bq25155::DisableFastCharge() {
+    BQ25155_BUS_API(DISABLE_FAST_CHARGE);
     if (!enterChargeReconfig()) { return false; }
     uint32_t chargeTarget_uA = getChargeCurrent();
     uint32_t prechargeTarget_uA = getPrechargeCurrent();
@@ -787,6 +2181,7 @@ bool bq25155::DisableFastCharge() {
     return exitChargeReconfig(ok);
 }
 bool bq25155::EnableFastCharge() {
+    BQ25155_BUS_API(ENABLE_FAST_CHARGE);
     if (!enterChargeReconfig()) { return false; }
     uint32_t chargeTarget_uA = getChargeCurrent();
     uint32_t prechargeTarget_uA = getPrechargeCurrent();
@@ -802,6 +2197,7 @@ bool bq25155::EnableFastCharge() {
 
 // --- Begin Charging Current Settings ---
 uint32_t bq25155::getChargeCurrent() {
+    BQ25155_BUS_API(GET_CHARGE_CURRENT);
     uint8_t ICHGbits = readRegister(REG_ICHG_CTRL);
     uint32_t current_uA = 0;
 
@@ -821,48 +2217,11 @@ uint32_t bq25155::getChargeCurrent() {
 }
 
 bool bq25155::setChargeCurrent(uint32_t current_uA) {
+    BQ25155_BUS_API(SET_CHARGE_CURRENT);
     if (!enterChargeReconfig()) { return false; }
 
-    const bool fastCharge = isFastChargeEnabled();
-    const uint32_t currentStep_uA = fastCharge ? 2500UL : 1250UL;
-    const uint32_t modeMax_uA = fastCharge ? 500000UL : 318750UL;
-
-    // Keep ICHG strictly below the currently configured ILIM level.
-    uint32_t ilim_uA = 50000UL;
-    switch (getILIM()) {
-        case ILIM_50MA:  ilim_uA = 50000UL; break;
-        case ILIM_100MA: ilim_uA = 100000UL; break;
-        case ILIM_150MA: ilim_uA = 150000UL; break;
-        case ILIM_200MA: ilim_uA = 200000UL; break;
-        case ILIM_300MA: ilim_uA = 300000UL; break;
-        case ILIM_400MA: ilim_uA = 400000UL; break;
-        case ILIM_500MA: ilim_uA = 500000UL; break;
-        case ILIM_600MA: ilim_uA = 600000UL; break;
-        default: break;
-    }
-    uint32_t maxAllowed_uA = (ilim_uA > currentStep_uA) ? (ilim_uA - currentStep_uA) : 0UL;
-    if (maxAllowed_uA > modeMax_uA) {
-        maxAllowed_uA = modeMax_uA;
-    }
-    if (current_uA > maxAllowed_uA) {
-        current_uA = maxAllowed_uA;
-    }
-
-    uint8_t Ibits = 0;
-
-    if (fastCharge) {
-        // 500,000 uA max charge current = 200 * 2500
-        if (current_uA >= 500000)
-            Ibits = 200;
-        else
-            Ibits = current_uA / 2500;
-    } else {
-        // 318,750 uA max charge current = 255 * 1250
-        if (current_uA >= 318750)
-            Ibits = 255;
-        else
-            Ibits = current_uA / 1250;
-    }
+    // Strictly below the configured ILIM level and within the ICHARGE_RANGE step range.
+    const uint8_t Ibits = ichgCode(current_uA, isFastChargeEnabled(), getILIM());
 
     bool ok = writeRegisterVerify(REG_ICHG_CTRL, Ibits, ICHG_CTRL_MASK);
     if (ok) {
@@ -875,6 +2234,7 @@ bool bq25155::setChargeCurrent(uint32_t current_uA) {
 
 // --- Begin Pre-Charging Current Settings ---
 uint32_t bq25155::getPrechargeCurrent() {
+    BQ25155_BUS_API(GET_PRECHARGE_CURRENT);
     uint8_t IPCHGbits = readRegister(REG_PCHRGCTRL) & IPRECHG_MASK;
     uint32_t current_uA = 0;
 
@@ -894,53 +2254,13 @@ uint32_t bq25155::getPrechargeCurrent() {
 }
 
 bool bq25155::setPreChargeCurrent(uint32_t current_uA) {
+    BQ25155_BUS_API(SET_PRECHARGE_CURRENT);
     if (!enterChargeReconfig()) { return false; }
 
-    const bool fastCharge = isFastChargeEnabled();
-    uint32_t maxPrecharge_uA = fastCharge ? 77500UL : 38750UL;
-
-    // Keep pre-charge current at/below the current ILIM setting.
-    uint32_t ilim_uA = 50000UL;
-    switch (getILIM()) {
-        case ILIM_50MA:  ilim_uA = 50000UL; break;
-        case ILIM_100MA: ilim_uA = 100000UL; break;
-        case ILIM_150MA: ilim_uA = 150000UL; break;
-        case ILIM_200MA: ilim_uA = 200000UL; break;
-        case ILIM_300MA: ilim_uA = 300000UL; break;
-        case ILIM_400MA: ilim_uA = 400000UL; break;
-        case ILIM_500MA: ilim_uA = 500000UL; break;
-        case ILIM_600MA: ilim_uA = 600000UL; break;
-        default: break;
-    }
-    if (maxPrecharge_uA > ilim_uA) {
-        maxPrecharge_uA = ilim_uA;
-    }
-
-    // Cap pre-charge current to 40% of currently configured ICHG.
-    uint32_t ichgBasedMax_uA = (getChargeCurrent() * 40UL) / 100UL;
-    if (maxPrecharge_uA > ichgBasedMax_uA) {
-        maxPrecharge_uA = ichgBasedMax_uA;
-    }
-    if (current_uA > maxPrecharge_uA) {
-        current_uA = maxPrecharge_uA;
-    }
-
+    // At/below the configured ILIM level and at most 40% of the programmed ICHG.
+    const uint8_t Ibits = iprechgCode(current_uA, isFastChargeEnabled(), getILIM(),
+                                      readRegister(REG_ICHG_CTRL));
     uint8_t IPCHGbits = readRegister(REG_PCHRGCTRL);
-    uint8_t Ibits = 0;
-
-    if (fastCharge) {
-        // 77,500 uA max pre-charge current = 31 * 2500
-        if (current_uA >= 77500)
-            Ibits = 31;
-        else
-            Ibits = current_uA / 2500;
-    } else {
-        // 38,750 uA max pre-charge current = 31 * 1250
-        if (current_uA >= 38750)
-            Ibits = 31;
-        else
-            Ibits = current_uA / 1250;
-    }
 
     IPCHGbits &= ~IPRECHG_MASK; // Clear b4:0
     IPCHGbits |= Ibits; // Set new bits
@@ -953,6 +2273,7 @@ bool bq25155::setPreChargeCurrent(uint32_t current_uA) {
 // --- Begin Termination Current Settings ---
 uint8_t bq25155::getITERM() { return (readRegister(REG_TERMCTRL) & ITERM_MASK) >> 1; } // Extract bits 5:1
 bool bq25155::setITERM(uint8_t percent) {
+    BQ25155_BUS_API(SET_ITERM);
     if (percent > 31) percent = 31;  // Range = 1% to 31% of ICHRG
     
     percent <<= 1;
@@ -1125,6 +2446,7 @@ uint8_t bq25155::getChgSafetyTimer() {
     return baseTenths;
 }
 bool bq25155::setChgSafetyTimer(uint8_t code) {
+    BQ25155_BUS_API(SET_CHG_SAFETY_TIMER);
     if (code > 3) code = 3;
     uint8_t r = readRegister(REG_CHARGERCTRL0);
     code <<= 1;
@@ -1230,6 +2552,7 @@ bool bq25155::setThermalTemperature(uint8_t Temp_C) {
 // --- Begin ILIMCTRL Settings - Input Current Limit Level Selection ---
 uint8_t bq25155::getILIM() { return (readRegister(REG_ILIMCTRL) & ILIM_MASK); }
 bool bq25155::setILIM(uint8_t code) {
+    BQ25155_BUS_API(SET_ILIM);
     if (code > 7) code = 7;
     if (!enterChargeReconfig()) { return false; }
 
@@ -1484,7 +2807,7 @@ bool bq25155::EnableGlobalIntMasks() {
     return writeRegister(REG_ICCTRL0, r);
 }
 
-bool bq25155::isHWResetEnabled() { return (readRegister(REG_ICCTRL0) & HW_RESET_MASK) != 0; }
+bool bq25155::isHWResetEnabled() { return (readRegisterUncached(REG_ICCTRL0) & HW_RESET_MASK) != 0; }
 bool bq25155::DisableHWReset() {
     uint8_t r = readRegister(REG_ICCTRL0);
     r &= ~HW_RESET_MASK; // 1b0 = Normal operation
@@ -1496,7 +2819,7 @@ bool bq25155::EnableHWReset() {
     return writeRegister(REG_ICCTRL0, r);
 }
 
-bool bq25155::isSWResetEnabled() { return (readRegister(REG_ICCTRL0) & SW_RESET_MASK) != 0; }
+bool bq25155::isSWResetEnabled() { return (readRegisterUncached(REG_ICCTRL0) & SW_RESET_MASK) != 0; }
 bool bq25155::DisableSWReset() {
     uint8_t r = readRegister(REG_ICCTRL0);
     r &= ~SW_RESET_MASK; // 1b0 = Normal operation
@@ -1666,6 +2989,7 @@ bool bq25155::EnableRST14sWD() {
 
 bool bq25155::isChargeEnabled() { return (readRegister(REG_ICCTRL2) & CHARGER_DISABLE_MASK) == 0; }
 bool bq25155::EnableCharge() {
+    BQ25155_BUS_API(ENABLE_CHARGE);
     digitalWrite(this->_CHEN_pin, LOW); // LOW to Enable charging
     uint8_t r = readRegister(REG_ICCTRL2);
     r &= ~CHARGER_DISABLE_MASK; // 1b0 = Charge enabled if /CE pin is low
@@ -1677,6 +3001,7 @@ bool bq25155::EnableCharge() {
     return refreshPGIndicatorFromState();
 }
 bool bq25155::DisableCharge() {
+    BQ25155_BUS_API(DISABLE_CHARGE);
     digitalWrite(this->_CHEN_pin, HIGH); // HIGH to Disable charging
     uint8_t r = readRegister(REG_ICCTRL2);
     r |= CHARGER_DISABLE_MASK; // 1b1 = Charge disabled
@@ -1699,33 +3024,33 @@ uint8_t bq25155::getADCReadRate() { return (readRegister(REG_ADCCTRL0) & ADC_REA
 bool bq25155::ADCManualRead() {
     uint8_t r = readRegister(REG_ADCCTRL0);
     r &= ~ADC_READ_RATE_MASK;
-    r |= ADC_READ_RATE_MANUAL;
+    r |= (ADC_READ_RATE_MANUAL << 6);
     return writeRegister(REG_ADCCTRL0, r);
 }
 // 2b01 = Continuous
 bool bq25155::ADCContinuousSamp() {
     uint8_t r = readRegister(REG_ADCCTRL0);
     r &= ~ADC_READ_RATE_MASK;
-    r |= ADC_READ_RATE_CNTNS;
+    r |= (ADC_READ_RATE_CNTNS << 6);
     return writeRegister(REG_ADCCTRL0, r);
 }
 // 2b10 = Every 1 second
 bool bq25155::ADC1sSamp() {
     uint8_t r = readRegister(REG_ADCCTRL0);
     r &= ~ADC_READ_RATE_MASK;
-    r |= ADC_READ_RATE_1S;
+    r |= (ADC_READ_RATE_1S << 6);
     return writeRegister(REG_ADCCTRL0, r);
 }
 // 2b11 = Every 1 minute
 bool bq25155::ADC1mSamp() {
     uint8_t r = readRegister(REG_ADCCTRL0);
     r &= ~ADC_READ_RATE_MASK;
-    r |= ADC_READ_RATE_1M;
+    r |= (ADC_READ_RATE_1M << 6);
     return writeRegister(REG_ADCCTRL0, r);
 }
 
 // ADC Conversion Start Trigger
-bool bq25155::getADCConvStart() { return (readRegister(REG_ADCCTRL0) & ADC_CONV_START_MASK) != 0; }
+bool bq25155::getADCConvStart() { return (readRegisterUncached(REG_ADCCTRL0) & ADC_CONV_START_MASK) != 0; }
 bool bq25155::NoADCConv() {
     uint8_t r = readRegister(REG_ADCCTRL0);
     r &= ~ADC_CONV_START_MASK; // 1b0 = No ADC conversion
@@ -1743,28 +3068,28 @@ uint8_t bq25155::getADCConvSpeed() { return (readRegister(REG_ADCCTRL0) & ADC_CO
 bool bq25155::setADCSpeedTo24ms() {
     uint8_t r = readRegister(REG_ADCCTRL0);
     r &= ~ADC_CONV_SPEED_MASK;
-    r |= ADC_CONV_SPEED_24MS;
+    r |= (ADC_CONV_SPEED_24MS << 3);
     return writeRegister(REG_ADCCTRL0, r);
 }
 // 2b01 = 12 ms (datasheet p11, samp>6 = 12-bit read?)
 bool bq25155::setADCSpeedTo12ms() {
     uint8_t r = readRegister(REG_ADCCTRL0);
     r &= ~ADC_CONV_SPEED_MASK;
-    r |= ADC_CONV_SPEED_12MS;
+    r |= (ADC_CONV_SPEED_12MS << 3);
     return writeRegister(REG_ADCCTRL0, r);
 }
 // 2b10 = 6 ms (datasheet p11, samp<6 = 10-bit read?)
 bool bq25155::setADCSpeedTo6ms() {
     uint8_t r = readRegister(REG_ADCCTRL0);
     r &= ~ADC_CONV_SPEED_MASK;
-    r |= ADC_CONV_SPEED_6MS;
+    r |= (ADC_CONV_SPEED_6MS << 3);
     return writeRegister(REG_ADCCTRL0, r);
 }
 // 2b11 = 3 ms (datasheet p11, samp<6 = 10-bit read?)
 bool bq25155::setADCSpeedTo3ms() {
     uint8_t r = readRegister(REG_ADCCTRL0);
     r &= ~ADC_CONV_SPEED_MASK;
-    r |= ADC_CONV_SPEED_3MS;
+    r |= (ADC_CONV_SPEED_3MS << 3);
     return writeRegister(REG_ADCCTRL0, r);
 }
 
@@ -1833,13 +3158,173 @@ bool bq25155::DisableADCComp3Ch() {
 // --- End REG_ADCCTRL1 Settings - ADC Comparators Set ---
 
 // --- Begin ADC Readings ---
-uint16_t bq25155::readVIN(uint8_t Vdecims) { return GenADCVRead(REG_ADC_DATA_VIN_M, REG_ADC_DATA_VIN_L, Vdecims, 1); }
-uint16_t bq25155::readPMID(uint8_t Vdecims) { return GenADCVRead(REG_ADC_DATA_PMID_M, REG_ADC_DATA_PMID_L, Vdecims, 1); }
-uint32_t bq25155::readIIN(uint8_t Vdecims) { return GenADCIRead(REG_ADC_DATA_IIN_M, REG_ADC_DATA_IIN_L, Vdecims); }
-uint16_t bq25155::readVBAT(uint8_t Vdecims) { return GenADCVRead(REG_ADC_DATA_VBAT_M, REG_ADC_DATA_VBAT_L, Vdecims, 1); }
-uint16_t bq25155::readTS(uint8_t Vdecims) { return GenADCVRead(REG_ADC_DATA_TS_M, REG_ADC_DATA_TS_L, Vdecims, 0); }
-uint16_t bq25155::readADCIN(uint8_t Vdecims) { return GenADCVRead(REG_ADC_DATA_ADCIN_M, REG_ADC_DATA_ADCIN_L, Vdecims, 0); }
-uint32_t bq25155::readICHG(uint8_t Vdecims) { return GenADCIPRead(REG_ADC_DATA_ICHG_M, REG_ADC_DATA_ICHG_L, Vdecims); }
+uint16_t bq25155::readVIN(uint8_t Vdecims) {
+    BQ25155_BUS_API(READ_VIN);
+    return GenADCVRead(REG_ADC_DATA_VIN_M, REG_ADC_DATA_VIN_L, Vdecims, 1);
+}
+uint16_t bq25155::readPMID(uint8_t Vdecims) {
+    BQ25155_BUS_API(READ_PMID);
+    return GenADCVRead(REG_ADC_DATA_PMID_M, REG_ADC_DATA_PMID_L, Vdecims, 1);
+}
+uint32_t bq25155::readIIN(uint8_t Vdecims) {
+    BQ25155_BUS_API(READ_IIN);
+    return GenADCIRead(REG_ADC_DATA_IIN_M, REG_ADC_DATA_IIN_L, Vdecims);
+}
+uint16_t bq25155::readVBAT(uint8_t Vdecims) {
+    BQ25155_BUS_API(READ_VBAT);
+    return GenADCVRead(REG_ADC_DATA_VBAT_M, REG_ADC_DATA_VBAT_L, Vdecims, 1);
+}
+uint16_t bq25155::readTS(uint8_t Vdecims) {
+    BQ25155_BUS_API(READ_TS);
+    return GenADCVRead(REG_ADC_DATA_TS_M, REG_ADC_DATA_TS_L, Vdecims, 0);
+}
+uint16_t bq25155::readADCIN(uint8_t Vdecims) {
+    BQ25155_BUS_API(READ_ADCIN);
+    return GenADCVRead(REG_ADC_DATA_ADCIN_M, REG_ADC_DATA_ADCIN_L, Vdecims, 0);
+}
+uint32_t bq25155::readICHG(uint8_t Vdecims) {
+    BQ25155_BUS_API(READ_ICHG);
+    return GenADCIPRead(REG_ADC_DATA_ICHG_M, REG_ADC_DATA_ICHG_L, Vdecims);
+}
+
+AdcSnapshot bq25155::readAdcSnapshot(uint8_t Vdecims) {
+    BQ25155_BUS_API(READ_ADC_SNAPSHOT);
+    uint8_t adcctrl0 = 0;
+    return readAdcFrame(Vdecims, adcctrl0);
+}
+
+// Raw codes in, snapshot out: masking and scaling with the cached conversion context.
+AdcSnapshot bq25155::scaleAdcFrame(const uint16_t (&raw)[ADC_CHANNEL_COUNT], uint8_t Vdecims) {
+    AdcSnapshot snap;
+    const AdcConversionContext &ctx = adcContext();
+    snap.adcSpeed = ctx.adcSpeed;
+    snap.ilimCode = ctx.ilimCode;
+    for (uint8_t ch = 0; ch < ADC_CHANNEL_COUNT; ch++) {
+        snap.raw[ch] = raw[ch] & ctx.resolutionMask;
+    }
+
+    snap.vbat_mV  = convertADCVoltage(snap.raw[(uint8_t)AdcChannel::VBAT], ctx, Vdecims, 1);
+    snap.ts_mV    = convertADCVoltage(snap.raw[(uint8_t)AdcChannel::TS], ctx, Vdecims, 0);
+    snap.ichg_pct = convertADCChargePercent(snap.raw[(uint8_t)AdcChannel::ICHG], ctx, Vdecims);
+    snap.adcin_mV = convertADCVoltage(snap.raw[(uint8_t)AdcChannel::ADCIN], ctx, Vdecims, 0);
+    snap.vin_mV   = convertADCVoltage(snap.raw[(uint8_t)AdcChannel::VIN], ctx, Vdecims, 1);
+    snap.pmid_mV  = convertADCVoltage(snap.raw[(uint8_t)AdcChannel::PMID], ctx, Vdecims, 1);
+    snap.iin_uA   = convertADCCurrent(snap.raw[(uint8_t)AdcChannel::IIN], ctx, Vdecims);
+    snap.valid = true;
+    return snap;
+}
+
+// adcctrl0 receives ADCCTRL0 from the same burst (ADC_CONV_START is still set mid-conversion).
+AdcSnapshot bq25155::readAdcFrame(uint8_t Vdecims, uint8_t &adcctrl0) {
+    BusSession session(*this);
+
+    // ADCCTRL0 (0x40) sits just below the data block: one burst gets the conversion
+    // speed and all seven MSB/LSB pairs (0x42-0x4F) from the same conversion set.
+    uint8_t block[REG_ADC_DATA_IIN_L - REG_ADCCTRL0 + 1];
+    if (!readRegisters(REG_ADCCTRL0, block, sizeof(block))) {
+        return AdcSnapshot();
+    }
+    const uint32_t sampleUs = micros();
+
+    adcctrl0 = block[0];
+    // The burst carries the live conversion speed: keep the cached context in step with it.
+    const uint8_t adcSpeed = (block[0] & ADC_CONV_SPEED_MASK) >> 3;
+    if (adcContext().adcSpeed != adcSpeed) {
+        _adcCtx = makeAdcContext(adcSpeed, _adcCtx.ilimCode);
+    }
+
+    uint16_t raw[ADC_CHANNEL_COUNT];
+    const uint8_t dataOffset = REG_ADC_DATA_VBAT_M - REG_ADCCTRL0;
+    for (uint8_t ch = 0; ch < ADC_CHANNEL_COUNT; ch++) {
+        raw[ch] = ((uint16_t)block[dataOffset + 2 * ch] << 8) | block[dataOffset + 2 * ch + 1];
+    }
+    AdcSnapshot snap = scaleAdcFrame(raw, Vdecims);
+
+    if (_adcSampleSink != nullptr) {
+        AdcSample sample;
+        sample.timestampUs = sampleUs;
+        for (uint8_t ch = 0; ch < ADC_CHANNEL_COUNT; ch++) { sample.raw[ch] = snap.raw[ch]; }
+        if (!_adcSampleSink(sample, _adcSampleContext)) { _adcSamplesDropped++; }
+    }
+
+    return snap;
+}
+
+bool bq25155::startAdcAcquisition(AdcSnapshotCallback callback, void *context, uint8_t Vdecims) {
+    BusSession session(*this);
+    _adcAcqCallback = callback;
+    _adcAcqContext = context;
+    _adcAcqDecims = Vdecims;
+    _adcAcqReady = false;
+
+    // Shadowed: the mask write only happens the first time.
+    if (get_ADC_READY_MASK() && !set_ADC_READY_MASK(false)) { return false; }
+    const uint8_t r = readRegister(REG_ADCCTRL0);
+    if (((r & ADC_READ_RATE_MASK) >> 6) == ADC_READ_RATE_MANUAL &&
+        !writeRegister(REG_ADCCTRL0, r | ADC_CONV_START_MASK)) {
+        return false;
+    }
+    _adcAcqPollMs = millis();
+    _adcAcqFlagSeen = false;
+    _adcAcqPending = true;
+    return true;
+}
+
+// Reads the frame; a stale ADC_READY (conversion still running) leaves the acquisition pending.
+bool bq25155::completeAdcAcquisition() {
+    uint8_t adcctrl0 = 0;
+    const AdcSnapshot snap = readAdcFrame(_adcAcqDecims, adcctrl0);
+    _adcAcqFlagSeen = false; // A stale flag waits for the next ADC_READY (or the fallback)
+    if (!snap.valid || (adcctrl0 & ADC_CONV_START_MASK) != 0) { return false; }
+
+    _adcAcqResult = snap;
+    _adcAcqPending = false;
+    _adcAcqReady = true;
+    if (_adcAcqCallback != nullptr) { _adcAcqCallback(_adcAcqResult, _adcAcqContext); }
+    return true;
+}
+
+void bq25155::serviceAdcAcquisition() {
+    if (!_adcAcqPending) { return; }
+    if (_adcAcqFlagSeen) {
+        completeAdcAcquisition();
+    } else if ((uint32_t)(millis() - _adcAcqPollMs) >= ADC_ACQUISITION_FALLBACK_MS) {
+        _adcAcqPollMs = millis();
+        completeAdcAcquisition(); // No ADC_READY seen: check the conversion directly
+    }
+}
+
+bool bq25155::adcAcquisitionReady() {
+    if (_adcAcqPending) {
+        if (_intPending) {
+            service();
+        } else {
+            serviceAdcAcquisition();
+        }
+    }
+    return _adcAcqReady;
+}
+
+bool bq25155::isAdcAcquisitionPending() const {
+    return _adcAcqPending;
+}
+
+void bq25155::cancelAdcAcquisition() {
+    _adcAcqPending = false;
+}
+
+const AdcSnapshot &bq25155::getAdcAcquisition() const {
+    return _adcAcqResult;
+}
+
+void bq25155::setAdcSampleSink(AdcSampleSink sink, void *context) {
+    _adcSampleSink = sink;
+    _adcSampleContext = context;
+}
+
+uint32_t bq25155::getAdcSamplesDropped() const {
+    return _adcSamplesDropped;
+}
 // --- End ADC Readings ---
 
 // --- Begin ADCALARM_COMPx Settings - ADC Comparators Values ---
@@ -1848,22 +3333,19 @@ uint16_t bq25155::readADCAlarms(uint8_t ADCAlarmCh, bool AlarmVal) {
     uint8_t Alarm_LSB = 0;
 
     switch (ADCAlarmCh) {
-        case 1:
-            Alarm_MSB = readRegister(REG_ADCALARM_COMP1_M);
-            Alarm_LSB = readRegister(REG_ADCALARM_COMP1_L);
-            break;
-        case 2:
-            Alarm_MSB = readRegister(REG_ADCALARM_COMP2_M);
-            Alarm_LSB = readRegister(REG_ADCALARM_COMP2_L);
-            break;
-        case 3:
-            Alarm_MSB = readRegister(REG_ADCALARM_COMP3_M);
-            Alarm_LSB = readRegister(REG_ADCALARM_COMP3_L);
-            break;
+        case 1: Alarm_MSB = REG_ADCALARM_COMP1_M; break;
+        case 2: Alarm_MSB = REG_ADCALARM_COMP2_M; break;
+        case 3: Alarm_MSB = REG_ADCALARM_COMP3_M; break;
         default:
             return 0;
     }
 
+    // COMPx_M/COMPx_L are contiguous: read both in one burst.
+    uint8_t raw[2] = {0x00, 0x00};
+    readRegisters(Alarm_MSB, raw, 2);
+    Alarm_MSB = raw[0];
+    Alarm_LSB = raw[1];
+
     if (AlarmVal) {
         // Concatenate 7:0 MSB & 7:4 LSB, For a total 12-bit value
         uint16_t threshold = (uint16_t)(Alarm_MSB << 4) | ((Alarm_LSB & ADCALARM_LSB) >> 4);
@@ -2182,6 +3664,7 @@ uint8_t bq25155::getDeviceID() {
         return 0x00;
 }
 
+#ifdef ARDUINO
 String bq25155::getDeviceIDString() {
     uint8_t deviceId = readRegister(REG_DEVICE_ID);
     if (deviceId == 0x35) // 0b00110101
@@ -2189,6 +3672,7 @@ String bq25155::getDeviceIDString() {
     else
         return "Unknown ID: 0x" + String(deviceId, HEX);
 }
+#endif
 // --- End DEVICE_ID ---
 
 /** // WIP
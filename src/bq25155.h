@@ -15,8 +15,46 @@
 #ifndef BQ25155_H
 #define BQ25155_H
 
-#include <Arduino.h>
-#include <Wire.h>
+#include "bq25155_port.h"
+#include "bq25155_transport.h"
+#include "bq25155_ring.h"
+#include "bq25155_filter.h"
+
+// Largest number of data bytes moved in one I2C burst. Matches the smallest common
+// Wire buffer (AVR BUFFER_LENGTH = 32); override with -DBQ25155_I2C_MAX_BURST=N on cores
+// with a larger buffer. Longer bursts are split into several transactions.
+#ifndef BQ25155_I2C_MAX_BURST
+#define BQ25155_I2C_MAX_BURST 32
+#endif
+
+// Write-through shadow copy of the R/W configuration registers (31 bytes of RAM).
+// Config getters are served from RAM and RMW setters skip their read. Set to 0 to compile out.
+#ifndef BQ25155_USE_SHADOW
+#define BQ25155_USE_SHADOW 1
+#endif
+
+// Per-API bus counters (getBusStats()). Costs BUS_API_COUNT x 24 bytes of RAM and a micros()
+// pair per transaction, so it is compiled out unless set to 1.
+#ifndef BQ25155_ENABLE_BUS_STATS
+#define BQ25155_ENABLE_BUS_STATS 0
+#endif
+
+// Slots in the per-fault rule table (addFaultRule()). Each slot costs about 10 bytes of RAM,
+// plus a fixed 64-byte bit-to-rule lookup. At most 32.
+#ifndef BQ25155_MAX_FAULT_RULES
+#define BQ25155_MAX_FAULT_RULES 8
+#endif
+#if BQ25155_MAX_FAULT_RULES < 1 || BQ25155_MAX_FAULT_RULES > 32
+#error "BQ25155_MAX_FAULT_RULES must be between 1 and 32"
+#endif
+
+// Consumers of the FLAG accumulator (registerFlagConsumer()), 4 bytes of RAM each. At most 8.
+#ifndef BQ25155_MAX_FLAG_CONSUMERS
+#define BQ25155_MAX_FLAG_CONSUMERS 4
+#endif
+#if BQ25155_MAX_FLAG_CONSUMERS < 1 || BQ25155_MAX_FLAG_CONSUMERS > 8
+#error "BQ25155_MAX_FLAG_CONSUMERS must be between 1 and 8"
+#endif
 
 namespace bq25155_const {
 
@@ -578,6 +616,71 @@ static constexpr auto REG_DEVICE_ID = (0x6F); //[R]: Device ID
 // Bitfield Mask
 static constexpr auto DEVICE_ID_DEF = (0x35); //8b00110101 = bq25155
 
+// Shadowed R/W configuration registers. Reserved addresses and the read-only ADC data
+// block (0x42-0x4F) inside the 0x07-0x65 map are skipped.
+struct RegisterRange {
+    uint8_t first;
+    uint8_t last;
+};
+static constexpr RegisterRange SHADOW_RANGES[] = {
+    {REG_MASK_0, REG_MASK_3},             // 0x07-0x0A
+    {REG_VBAT_CTRL, REG_ILIMCTRL},        // 0x12-0x19
+    {REG_LDOCTRL, REG_LDOCTRL},           // 0x1D
+    {REG_MRCTRL, REG_MRCTRL},             // 0x30
+    {REG_ICCTRL0, REG_ICCTRL2},           // 0x35-0x37
+    {REG_ADCCTRL0, REG_ADCCTRL1},         // 0x40-0x41
+    {REG_ADCALARM_COMP1_M, REG_ADC_READ_EN}, // 0x52-0x58
+    {REG_TS_FASTCHGCTRL, REG_TS_HOT}      // 0x61-0x65
+};
+static constexpr uint8_t SHADOW_RANGE_COUNT = sizeof(SHADOW_RANGES) / sizeof(SHADOW_RANGES[0]);
+static constexpr uint8_t SHADOW_REG_COUNT = 31;
+constexpr uint8_t shadowRangeRegs(uint8_t i = 0) {
+    return (i == SHADOW_RANGE_COUNT) ? 0
+           : (uint8_t)(SHADOW_RANGES[i].last - SHADOW_RANGES[i].first + 1 + shadowRangeRegs(i + 1));
+}
+static_assert(shadowRangeRegs() == SHADOW_REG_COUNT, "SHADOW_REG_COUNT must match SHADOW_RANGES");
+static_assert(SHADOW_REG_COUNT <= 32, "Shadow valid/dirty bitmasks are 32-bit");
+static constexpr uint8_t SHADOW_NONE = 0xFF;
+// Shadowed registers with a known reset default, in the order checkForChipReset() tries them as
+// the sentinel (charge settings first: a profile almost always moves them off their defaults).
+struct RegisterDefault {
+    uint8_t reg;
+    uint8_t value;
+};
+static constexpr RegisterDefault RESET_SENTINEL_CANDIDATES[] = {
+    {REG_ICHG_CTRL, ICHG_CTRL_DEF},
+    {REG_VBAT_CTRL, VBAT_REG_DEF},
+    {REG_PCHRGCTRL, IPRECHG_DEF},
+    {REG_ILIMCTRL, ILIM_100MA},
+    {REG_TERMCTRL, ITERM_DEF},
+    {REG_CHARGERCTRL0, CHARGERCTRL0_DEF},
+    {REG_CHARGERCTRL1, CHARGERCTRL1_DEF},
+    {REG_TS_FASTCHGCTRL, TS_FASTCHGCTRL_DEF},
+    {REG_TS_COLD, TS_COLD_DEF},
+    {REG_TS_COOL, TS_COOL_DEF},
+    {REG_TS_WARM, TS_WARM_DEF},
+    {REG_TS_HOT, TS_HOT_DEF},
+    {REG_LDOCTRL, LDOCTRL_DEF},
+    {REG_MRCTRL, MRCTRL_DEF},
+    {REG_MASK_2, MASK2_DEF},
+    {REG_ADCCTRL1, ADCCTRL1_DEF},
+    {REG_ADCALARM_COMP1_M, ADCALARM_COMP1_M_DEF},
+    {REG_ADCALARM_COMP1_L, ADCALARM_COMP1_L_DEF},
+    {REG_ADCALARM_COMP2_M, ADCALARM_COMP2_M_DEF},
+    {REG_ADCALARM_COMP2_L, ADCALARM_COMP2_L_DEF}
+};
+static constexpr uint8_t RESET_SENTINEL_CANDIDATE_COUNT =
+    sizeof(RESET_SENTINEL_CANDIDATES) / sizeof(RESET_SENTINEL_CANDIDATES[0]);
+// Every shadow index: readConfigSpace() read the whole configuration space.
+static constexpr uint32_t CONFIG_SPACE_ALL = (1UL << SHADOW_REG_COUNT) - 1;
+// begin() argument / getConfigChecksum() result meaning "no checksum" (CRCs are 16-bit).
+static constexpr uint32_t CONFIG_CHECKSUM_NONE = 0xFFFFFFFFUL;
+// resyncShadow() reads neighbouring ranges in one burst when the reserved gap is this small.
+static constexpr uint8_t SHADOW_MERGE_GAP = 10;
+static constexpr uint8_t SHADOW_SYNC_SPAN_MAX = 32;
+// commitConfigTransaction() rewrites up to this many unchanged registers to join two bursts.
+static constexpr uint8_t STAGE_BRIDGE_GAP = 2;
+
 enum class ChargeStatus : uint8_t {
     BQ_NOT_CHARGING = 0,
     BQ_PRECHARGE,
@@ -585,6 +688,37 @@ enum class ChargeStatus : uint8_t {
     BQ_CHARGE_DONE,
     BQ_UNKNOWN_STATUS
 };
+static constexpr uint8_t CHARGE_STATUS_COUNT = static_cast<uint8_t>(ChargeStatus::BQ_UNKNOWN_STATUS) + 1;
+
+// While in PRECHARGE nothing in STAT0/STAT1 marks the step to fast charge, so VBAT is
+// re-checked against VLOWV at most this often.
+static constexpr uint16_t CHARGE_PHASE_VBAT_RECHECK_MS = 1000;
+
+// Charge phase tracker output (getChargePhaseStats()). Times are millis() based.
+struct ChargePhaseStats {
+    ChargeStatus phase = ChargeStatus::BQ_UNKNOWN_STATUS;
+    bool constantVoltage = false;             // FASTCHARGE in CV (taper)
+    uint32_t enteredMs = 0;                   // millis() at the last phase change
+    uint32_t previousEnteredMs = 0;           // millis() when the previous phase started
+    ChargeStatus previousPhase = ChargeStatus::BQ_UNKNOWN_STATUS;
+    uint32_t transitions = 0;
+    uint32_t totalMs[CHARGE_STATUS_COUNT] = {}; // Cumulative time per phase, indexed by ChargeStatus
+};
+
+// I2C watchdog timeouts: HWRESET_14S_WD (HW reset 14 s after VIN with no I2C) and the charger
+// watchdog of CHARGERCTRL0 (registers back to defaults after 50 s with no I2C).
+static constexpr uint32_t HWRESET_WD_TIMEOUT_MS = 14000;
+static constexpr uint32_t I2C_WATCHDOG_TIMEOUT_MS = 50000;
+// Default lead time of the watchdog keeper's keep-alive before the deadline.
+static constexpr uint32_t WATCHDOG_KEEPER_MARGIN_MS = 2000;
+
+// Watchdog keeper report (getWatchdogKeeperStats()). Times are millis() based.
+struct WatchdogKeeperStats {
+    uint32_t timeoutMs = 0;       // Watchdog being fed, 0 when the keeper is off
+    uint32_t lastActivityMs = 0;  // millis() of the last successful I2C transaction of any kind
+    uint32_t keepAlives = 0;      // Dedicated keep-alive reads that succeeded
+    int32_t minMarginMs = 0;      // Smallest timeout - gap between two transactions (< 0: missed)
+};
 
 enum class BatteryChemistry : uint8_t {
     LI_ION_4V2 = 0, // 4.20 V max
@@ -707,6 +841,59 @@ enum class TSThresholdRegister : uint8_t {
     HOT = REG_TS_HOT
 };
 
+// Index of each channel inside AdcSnapshot::raw (same order as registers 0x42-0x4F).
+enum class AdcChannel : uint8_t {
+    VBAT = 0,
+    TS,
+    ICHG,
+    ADCIN,
+    VIN,
+    PMID,
+    IIN
+};
+static constexpr uint8_t ADC_CHANNEL_COUNT = 7;
+
+// All seven ADC channels taken from one burst of 0x40-0x4F, so every value comes from the
+// same conversion set and is scaled with the same ADCCTRL0/ILIMCTRL settings.
+struct AdcSnapshot {
+    bool valid = false;                    // false if the I2C burst failed
+    uint8_t adcSpeed = 0;                  // ADC_CONV_SPEED code used for resolution masking
+    uint8_t ilimCode = 0;                  // ILIM code used for the IIN full scale
+    uint16_t raw[ADC_CHANNEL_COUNT] = {};  // Resolution-masked raw codes, indexed by AdcChannel
+    uint16_t vbat_mV = 0;
+    uint16_t ts_mV = 0;
+    uint32_t ichg_pct = 0;                 // Percent of ICHARGE with 3 implied decimals (12345 = 12.345%)
+    uint16_t adcin_mV = 0;
+    uint16_t vin_mV = 0;
+    uint16_t pmid_mV = 0;
+    uint32_t iin_uA = 0;
+};
+
+// Scaling inputs of the ADC readers, derived from ADCCTRL0 and ILIMCTRL. The driver keeps one
+// cached copy and refreshes it on writes to those registers (getAdcConversionContext()).
+struct AdcConversionContext {
+    bool valid = false;
+    uint8_t adcSpeed = 0;                // ADC_CONV_SPEED code (0 = 24 ms .. 3 = 3 ms)
+    uint16_t resolutionMask = 0xFFF0;    // 12-bit at 24/12 ms, 10-bit at 6/3 ms, left aligned
+    uint8_t ilimCode = 0;                // ILIM code
+    uint32_t iinFullScale_uA = 375000;   // 375 mA for ILIM <= 150 mA, 750 mA above
+    uint16_t ichgFullScale = 52429;      // Code of 100% ICHARGE (0.8 x 65536)
+};
+
+// Result hook of startAdcAcquisition(), run from service() once the frame has been read.
+typedef void (*AdcSnapshotCallback)(const AdcSnapshot &snapshot, void *context);
+// Timestamped raw frame handed to the sample sink (setAdcSampleSink()) on every frame read.
+struct AdcSample {
+    uint32_t timestampUs = 0;              // micros() right after the burst
+    uint16_t raw[ADC_CHANNEL_COUNT] = {};  // Resolution-masked raw codes, indexed by AdcChannel
+};
+// Called from the context that read the frame (service(), adcAcquisitionReady(),
+// readAdcSnapshot()). Returns false when the sample could not be stored.
+typedef bool (*AdcSampleSink)(const AdcSample &sample, void *context);
+// adcAcquisitionReady() reads the frame itself when no ADC_READY INT arrived within this time
+// (INT not wired or masked elsewhere), and again after each further interval.
+static constexpr uint16_t ADC_ACQUISITION_FALLBACK_MS = 200;
+
 struct ChargeProfile {
     uint16_t chargeVoltage_mV = 4200;
     bool enableFastCharge = true;
@@ -718,12 +905,322 @@ struct ChargeProfile {
     bool ledOnWhenChargeDone = true;
 };
 
+// Register image of a ChargeProfile: 0x12-0x19 (VBAT_CTRL..ILIMCTRL) plus ICCTRL2. Only the
+// bits in CHARGE_IMAGE_MASKS / CHARGE_IMAGE_ICCTRL2_MASK come from the profile; everything
+// else keeps the value read from the device when the image is applied.
+static constexpr uint8_t CHARGE_IMAGE_FIRST = REG_VBAT_CTRL;
+static constexpr uint8_t CHARGE_IMAGE_LEN = REG_ILIMCTRL - REG_VBAT_CTRL + 1;
+static constexpr uint8_t CHARGE_IMAGE_MASKS[CHARGE_IMAGE_LEN] = {
+    VBAT_REG_MASK,                                // 0x12 VBAT_CTRL
+    ICHG_CTRL_MASK,                               // 0x13 ICHG_CTRL
+    ICHARGE_RANGE_MASK | IPRECHG_MASK,            // 0x14 PCHRGCTRL
+    0x00,                                         // 0x15 TERMCTRL
+    0x00,                                         // 0x16 BUVLO
+    SFT_2XTMR_EN_MASK | SAFETY_TIMER_LIMIT_MASK,  // 0x17 CHARGERCTRL0
+    0x00,                                         // 0x18 CHARGERCTRL1
+    ILIM_MASK                                     // 0x19 ILIMCTRL
+};
+static constexpr uint8_t CHARGE_IMAGE_ICCTRL2_MASK = CHARGER_DISABLE_MASK | GPO_PG_MASK;
+
+struct ChargeImage {
+    uint8_t regs[CHARGE_IMAGE_LEN];
+    uint8_t icctrl2; // CHARGER_DISABLE (always 0: charge on) and GPO_PG for a fresh charge cycle
+};
+
+// constexpr charge profile arithmetic: the only copy of the clamping rules. setChargeVoltage(),
+// setChargeCurrent() and setPreChargeCurrent() call it at run time, StaticChargeProfile at
+// compile time and applyChargeProfile() for a whole image.
+constexpr uint16_t chemistryMaxChargeVoltage_mV(BatteryChemistry chemistry) {
+    return (chemistry == BatteryChemistry::LI_HV_4V35) ? 4350 :
+           (chemistry == BatteryChemistry::LI_HV_4V4)  ? 4400 : 4200;
+}
+
+// VBATREG = 3.6 V + code x 10 mV, clamped to [3.6 V, chemistry max] and 4.6 V (code 100).
+constexpr uint8_t vbatRegCode(uint16_t mV, BatteryChemistry chemistry) {
+    return (mV < 3600) ? 0 :
+           (mV > chemistryMaxChargeVoltage_mV(chemistry)) ? vbatRegCode(chemistryMaxChargeVoltage_mV(chemistry), chemistry) :
+           ((mV - 3600) / 10 > 100) ? 100 : (uint8_t)((mV - 3600) / 10);
+}
+
+constexpr uint32_t ilimLevel_uA(uint8_t ilimCode) {
+    return (ilimCode == ILIM_50MA)  ? 50000UL :
+           (ilimCode == ILIM_100MA) ? 100000UL :
+           (ilimCode == ILIM_150MA) ? 150000UL :
+           (ilimCode == ILIM_200MA) ? 200000UL :
+           (ilimCode == ILIM_300MA) ? 300000UL :
+           (ilimCode == ILIM_400MA) ? 400000UL :
+           (ilimCode == ILIM_500MA) ? 500000UL :
+           (ilimCode == ILIM_600MA) ? 600000UL : 50000UL;
+}
+
+constexpr uint32_t ichgStep_uA(bool fastCharge) { return fastCharge ? 2500UL : 1250UL; }
+constexpr uint32_t ichgRangeMax_uA(bool fastCharge) { return fastCharge ? 500000UL : 318750UL; }
+constexpr uint32_t iprechgRangeMax_uA(bool fastCharge) { return fastCharge ? 77500UL : 38750UL; }
+
+// Highest ICHG accepted: one step below ILIM, within the step range.
+constexpr uint32_t ichgLimit_uA(bool fastCharge, uint8_t ilimCode) {
+    return (ilimLevel_uA(ilimCode) <= ichgStep_uA(fastCharge)) ? 0UL :
+           (ilimLevel_uA(ilimCode) - ichgStep_uA(fastCharge) > ichgRangeMax_uA(fastCharge))
+               ? ichgRangeMax_uA(fastCharge)
+               : ilimLevel_uA(ilimCode) - ichgStep_uA(fastCharge);
+}
+
+constexpr uint8_t ichgCode(uint32_t uA, bool fastCharge, uint8_t ilimCode) {
+    return (uA > ichgLimit_uA(fastCharge, ilimCode)) ? ichgCode(ichgLimit_uA(fastCharge, ilimCode), fastCharge, ilimCode) :
+           (uA >= ichgRangeMax_uA(fastCharge)) ? (fastCharge ? 200 : 255) :
+           (uint8_t)(uA / ichgStep_uA(fastCharge));
+}
+
+constexpr uint32_t minU32(uint32_t a, uint32_t b) { return (a < b) ? a : b; }
+
+// Highest IPRECHG accepted: at/below ILIM and at most 40% of the programmed ICHG (the code
+// read back as getChargeCurrent() does, capped at the range maximum).
+constexpr uint32_t iprechgLimit_uA(bool fastCharge, uint8_t ilimCode, uint8_t ichg) {
+    return minU32(minU32(iprechgRangeMax_uA(fastCharge), ilimLevel_uA(ilimCode)),
+                  (minU32((uint32_t)ichg * ichgStep_uA(fastCharge), ichgRangeMax_uA(fastCharge)) * 40UL) / 100UL);
+}
+
+constexpr uint8_t iprechgCode(uint32_t uA, bool fastCharge, uint8_t ilimCode, uint8_t ichg) {
+    return (uA > iprechgLimit_uA(fastCharge, ilimCode, ichg))
+               ? iprechgCode(iprechgLimit_uA(fastCharge, ilimCode, ichg), fastCharge, ilimCode, ichg) :
+           (uA >= iprechgRangeMax_uA(fastCharge)) ? 31 :
+           (uint8_t)(uA / ichgStep_uA(fastCharge));
+}
+
+constexpr uint8_t chargeTimerBits(SafetyTimerLimit timer, bool use2x) {
+    return (uint8_t)((use2x ? SFT_2XTMR_EN_MASK : 0) |
+                     (((static_cast<uint8_t>(timer) > 3) ? 3 : static_cast<uint8_t>(timer)) << 1));
+}
+
+constexpr ChargeImage makeChargeImageCodes(uint8_t vbat, bool fastCharge, uint8_t ichg, uint8_t iprechg,
+                                           uint8_t ilimCode, uint8_t timerBits, bool ledOnWhenChargeDone) {
+    return ChargeImage{
+        { vbat, ichg, (uint8_t)((fastCharge ? ICHARGE_RANGE_MASK : 0) | iprechg), 0x00, 0x00,
+          timerBits, 0x00, ilimCode },
+        // Charge on; a new cycle starts with the done latch clear (GPO_PG: 1b0 = pulled down).
+        (uint8_t)(ledOnWhenChargeDone ? GPO_PG_MASK : 0)
+    };
+}
+
+constexpr ChargeImage makeChargeImage(uint16_t chargeVoltage_mV, bool fastCharge, uint32_t chargeCurrent_uA,
+                                      uint32_t prechargeCurrent_uA, ILIMLevel inputCurrentLimit,
+                                      SafetyTimerLimit safetyTimer, bool use2xSafetyTimer,
+                                      bool ledOnWhenChargeDone, BatteryChemistry chemistry) {
+    return makeChargeImageCodes(
+        vbatRegCode(chargeVoltage_mV, chemistry), fastCharge,
+        ichgCode(chargeCurrent_uA, fastCharge, static_cast<uint8_t>(inputCurrentLimit) & ILIM_MASK),
+        iprechgCode(prechargeCurrent_uA, fastCharge, static_cast<uint8_t>(inputCurrentLimit) & ILIM_MASK,
+                    ichgCode(chargeCurrent_uA, fastCharge, static_cast<uint8_t>(inputCurrentLimit) & ILIM_MASK)),
+        static_cast<uint8_t>(inputCurrentLimit) & ILIM_MASK, chargeTimerBits(safetyTimer, use2xSafetyTimer),
+        ledOnWhenChargeDone);
+}
+
+constexpr ChargeImage compileChargeProfile(const ChargeProfile &profile, BatteryChemistry chemistry) {
+    return makeChargeImage(profile.chargeVoltage_mV, profile.enableFastCharge, profile.chargeCurrent_uA,
+                           profile.prechargeCurrent_uA, profile.inputCurrentLimit, profile.safetyTimer,
+                           profile.use2xSafetyTimer, profile.ledOnWhenChargeDone, chemistry);
+}
+
+// Instrumented entry points for getBusStats(). At most 32 (tracked in a bitmask).
+enum class BusApi : uint8_t {
+    BEGIN = 0,
+    APPLY_CHARGE_PROFILE,
+    ENFORCE_SAFETY_FAULT_POLICY,
+    READ_ALL_FLAGS,
+    CLEAR_ALL_FLAGS,
+    SET_CHARGE_VOLTAGE,
+    SET_CHARGE_CURRENT,
+    GET_CHARGE_CURRENT,
+    SET_PRECHARGE_CURRENT,
+    GET_PRECHARGE_CURRENT,
+    IS_FAST_CHARGE_ENABLED,
+    ENABLE_FAST_CHARGE,
+    DISABLE_FAST_CHARGE,
+    SET_ITERM,
+    SET_ILIM,
+    SET_CHG_SAFETY_TIMER,
+    ENABLE_CHARGE,
+    DISABLE_CHARGE,
+    SET_INT_MASK,              // Any set_*_MASK()
+    READ_ADC_SNAPSHOT,
+    READ_VBAT,
+    READ_TS,
+    READ_ICHG,
+    READ_ADCIN,
+    READ_VIN,
+    READ_PMID,
+    READ_IIN,
+    RESYNC_SHADOW,
+    COMMIT_CONFIG_TRANSACTION,
+    READ_STATUS,
+    EVALUATE_FAULT_RULES,
+    OTHER                      // Traffic outside every instrumented call
+};
+static constexpr uint8_t BUS_API_COUNT = static_cast<uint8_t>(BusApi::OTHER) + 1;
+
+struct BusStats {
+    uint32_t calls = 0;        // Entries into the API (nested re-entries included)
+    uint32_t transactions = 0; // I2C transactions (a split burst counts each chunk)
+    uint32_t bytes = 0;        // Bytes on the wire: address, register and data bytes
+    uint32_t lpmToggles = 0;   // LPM pin edges
+    uint32_t busMicros = 0;    // Time inside transactions
+    uint32_t callMicros = 0;   // Wall time of the outermost call
+};
+
+// Charger events, numbered by FLAG bit: FLAGn bit b is event n * 8 + b. The same layout is
+// used for the 32-bit FLAG word returned by service() and for MASK0-3 in setInterruptMasks().
+enum class ChargerEvent : uint8_t {
+    VIN_PGOOD = 0,
+    THERMREG_ACTIVE = 1,
+    VINDPM_ACTIVE = 2,
+    VDPPM_ACTIVE = 3,
+    IINLIM_ACTIVE = 4,
+    CHARGE_DONE = 5,
+    CHRG_CV = 6,
+    TS_HOT = 8,
+    TS_WARM = 9,
+    TS_COOL = 10,
+    TS_COLD = 11,
+    BAT_UVLO_FAULT = 12,
+    BAT_OCP_FAULT = 13,
+    VIN_OVP_FAULT = 15,
+    TS_OPEN = 16,
+    COMP3_ALARM = 20,
+    COMP2_ALARM = 21,
+    COMP1_ALARM = 22,
+    ADC_READY = 23,
+    MRRESET_WARN = 24,
+    MRWAKE2_TIMEOUT = 25,
+    MRWAKE1_TIMEOUT = 26,
+    LDO_OCP_FAULT = 28,
+    SAFETY_TMR_FAULT = 29,
+    WD_FAULT = 30
+};
+static constexpr uint8_t CHARGER_EVENT_COUNT = 32;
+static constexpr uint32_t eventBit(ChargerEvent event) { return 1UL << static_cast<uint8_t>(event); }
+
+typedef void (*ChargerEventCallback)(ChargerEvent event, void *context);
+
+// STAT0-2 (and optionally FLAG0-3) from one burst of 0x00-0x02 / 0x00-0x06. The status word
+// packs STAT0 in bits 0-7, STAT1 in bits 8-15 and STAT2 in bits 16-23; the flag word uses the
+// ChargerEvent layout. Accessors decode the captured bytes and never touch the bus.
+struct StatusSnapshot {
+    uint32_t status = 0;
+    uint32_t flags = 0;
+    bool valid = false;          // false if the I2C burst failed
+    bool flagsIncluded = false;  // true if FLAG0-3 were read (and cleared) by the same burst
+
+    uint8_t stat0() const { return static_cast<uint8_t>(status); }
+    uint8_t stat1() const { return static_cast<uint8_t>(status >> 8); }
+    uint8_t stat2() const { return static_cast<uint8_t>(status >> 16); }
+
+    // STAT0
+    bool chrgCV() const { return (stat0() & CHRG_CV_STAT_MASK) != 0; }
+    bool chargeDone() const { return (stat0() & CHARGE_DONE_STAT_MASK) != 0; }
+    bool iinlimActive() const { return (stat0() & IINLIM_ACTIVE_STAT_MASK) != 0; }
+    bool vdppmActive() const { return (stat0() & VDPPM_ACTIVE_STAT_MASK) != 0; }
+    bool vindpmActive() const { return (stat0() & VINDPM_ACTIVE_STAT_MASK) != 0; }
+    bool thermregActive() const { return (stat0() & THERMREG_ACTIVE_STAT_MASK) != 0; }
+    bool vinPgood() const { return (stat0() & VIN_PGOOD_STAT_MASK) != 0; }
+    // STAT1
+    bool vinOvp() const { return (stat1() & VIN_OVP_FAULT_STAT_MASK) != 0; }
+    bool batOcp() const { return (stat1() & BAT_OCP_FAULT_STAT_MASK) != 0; }
+    bool batUvlo() const { return (stat1() & BAT_UVLO_FAULT_STAT_MASK) != 0; }
+    bool tsCold() const { return (stat1() & TS_COLD_STAT_MASK) != 0; }
+    bool tsCool() const { return (stat1() & TS_COOL_STAT_MASK) != 0; }
+    bool tsWarm() const { return (stat1() & TS_WARM_STAT_MASK) != 0; }
+    bool tsHot() const { return (stat1() & TS_HOT_STAT_MASK) != 0; }
+    bool chargeSuspended() const { return (stat1() & (TS_COLD_STAT_MASK | TS_HOT_STAT_MASK)) != 0; }
+    // STAT2
+    bool comp1Alarm() const { return (stat2() & COMP1_ALARM_STAT_MASK) != 0; }
+    bool comp2Alarm() const { return (stat2() & COMP2_ALARM_STAT_MASK) != 0; }
+    bool comp3Alarm() const { return (stat2() & COMP3_ALARM_STAT_MASK) != 0; }
+    bool tsOpen() const { return (stat2() & TS_OPEN_STAT_MASK) != 0; }
+    // FLAG0-3 (always false unless flagsIncluded)
+    bool flag(ChargerEvent event) const { return (flags & eventBit(event)) != 0; }
+};
+
+// Severe-fault masks for enforceSafetyFaultPolicy(). status uses the StatusSnapshot::status
+// layout (STAT0-2), flags the ChargerEvent layout (FLAG0-3). Extend with setSevereFaultMasks().
+struct FaultMaskTable {
+    uint32_t status;
+    uint32_t flags;
+};
+
+// Per-fault rules (addFaultRule()). STAT0-2 and FLAG0-3 share the ChargerEvent bit layout
+// (STATn bit b = FLAGn bit b), so a rule names its condition with a ChargerEvent and picks
+// the live status bit or the latched flag bit with FaultSource.
+enum class FaultSource : uint8_t {
+    STATUS = 0, // STAT0-2: condition present now
+    FLAG        // FLAG0-3: condition seen since the previous FLAG read (evaluateFaultRules(true) only)
+};
+
+enum class FaultAction : uint8_t {
+    DISABLE_CHARGE = 0,   // Charge off; re-enabled on clear if it was on when tripped
+    SCALE_CHARGE_CURRENT, // param: percent (1-100) of the charge current in force when tripped
+    DROP_ILIM,            // param: ILIMLevel code to lower ILIM to (never raises it)
+    REDUCE_VBAT,          // param: setTSVCHG() reduction in mV (applied by the device in TS WARM)
+    LOG_ONLY,             // Only counted: getFaultRuleTrips()
+    CALLBACK              // Calls the onFaultRule() callback on trip and on clear
+};
+static constexpr uint8_t FAULT_ACTION_COUNT = static_cast<uint8_t>(FaultAction::CALLBACK) + 1;
+
+struct FaultRule {
+    ChargerEvent condition;
+    FaultSource source;
+    FaultAction action;
+    uint8_t tripSamples;  // Consecutive samples with the bit set before the action runs (>= 1)
+    uint8_t clearSamples; // Consecutive samples with the bit clear before it is undone (>= 1)
+    uint16_t param;       // Action argument, see FaultAction
+};
+
+typedef void (*FaultRuleCallback)(uint8_t ruleIndex, bool tripped, void *context);
+
+static constexpr FaultMaskTable DEFAULT_SEVERE_FAULTS = {
+    // STAT1: VIN OVP, BAT OCP, BAT UVLO, TS cold, TS hot. STAT2: TS open.
+    ((uint32_t)(VIN_OVP_FAULT_STAT_MASK | BAT_OCP_FAULT_STAT_MASK | BAT_UVLO_FAULT_STAT_MASK |
+                TS_COLD_STAT_MASK | TS_HOT_STAT_MASK) << 8) |
+        ((uint32_t)TS_OPEN_STAT_MASK << 16),
+    // FLAG1-3: the same conditions plus watchdog, safety timer and LDO OCP faults.
+    ((uint32_t)(VIN_OVP_FAULT_FLAG_MASK | BAT_OCP_FAULT_FLAG_MASK | BAT_UVLO_FAULT_FLAG_MASK |
+                TS_COLD_FLAG_MASK | TS_HOT_FLAG_MASK) << 8) |
+        ((uint32_t)TS_OPEN_FLAG_MASK << 16) |
+        ((uint32_t)(WD_FAULT_FLAG_MASK | SAFETY_TMR_FAULT_FLAG_MASK | LDO_OCP_FAULT_FLAG_MASK) << 24)
+};
+
+// How setters that rewrite the charge registers (0x12-0x19) pause charging.
+enum class ChargeReconfigMode : uint8_t {
+    PER_CALL = 0, // /CE + CHARGER_DISABLE for the whole setter chain, including its reads and verifies
+    STAGED_WINDOW // Stage the chain, then /CE only around the burst writes (needs BQ25155_USE_SHADOW)
+};
+
 
 } // namespace bq25155_const
 
 // User-facing alias for cleaner sketches.
 using BatteryChemistry = bq25155_const::BatteryChemistry;
 using ChargeProfile = bq25155_const::ChargeProfile;
+using ChargeImage = bq25155_const::ChargeImage;
+using ChargeStatus = bq25155_const::ChargeStatus;
+using ChargePhaseStats = bq25155_const::ChargePhaseStats;
+using WatchdogKeeperStats = bq25155_const::WatchdogKeeperStats;
+using AdcChannel = bq25155_const::AdcChannel;
+using AdcSnapshot = bq25155_const::AdcSnapshot;
+using AdcConversionContext = bq25155_const::AdcConversionContext;
+using AdcSnapshotCallback = bq25155_const::AdcSnapshotCallback;
+using AdcSample = bq25155_const::AdcSample;
+using AdcSampleSink = bq25155_const::AdcSampleSink;
+using BusApi = bq25155_const::BusApi;
+using BusStats = bq25155_const::BusStats;
+using ChargerEvent = bq25155_const::ChargerEvent;
+using ChargerEventCallback = bq25155_const::ChargerEventCallback;
+using StatusSnapshot = bq25155_const::StatusSnapshot;
+using FaultMaskTable = bq25155_const::FaultMaskTable;
+using FaultSource = bq25155_const::FaultSource;
+using FaultAction = bq25155_const::FaultAction;
+using FaultRule = bq25155_const::FaultRule;
+using FaultRuleCallback = bq25155_const::FaultRuleCallback;
+using ChargeReconfigMode = bq25155_const::ChargeReconfigMode;
 using AlarmComparator = bq25155_const::AlarmComparator;
 using UVLOLevel = bq25155_const::UVLOLevel;
 using SafetyTimerLimit = bq25155_const::SafetyTimerLimit;
@@ -742,18 +1239,231 @@ static constexpr BatteryChemistry LI_ION_4V2 = BatteryChemistry::LI_ION_4V2;
 static constexpr BatteryChemistry LI_HV_4V35 = BatteryChemistry::LI_HV_4V35;
 static constexpr BatteryChemistry LI_HV_4V4 = BatteryChemistry::LI_HV_4V4;
 
+// Lock-free producer/consumer queue of ADC frames (bq25155_ring.h). Capacity is a power of two,
+// at most 128 on AVR:
+//   AdcSampleRing<16> samples;
+//   charger.attachAdcSampleRing(samples);   // frames read by service() are pushed
+//   AdcSample s; while (samples.pop(s)) { log(s); }
+template <typename T, uint16_t Capacity>
+using SpscRing = bq25155_ring::SpscRing<T, Capacity>;
+template <uint16_t Capacity>
+using AdcSampleRing = bq25155_ring::SpscRing<AdcSample, Capacity>;
+
+// One fixed-point filter per ADC channel (bq25155_filter.h), fed with raw frames:
+//   AdcFilterBank<bq25155_filter::Median<5>> spikes;
+//   spikes.updateFrame(charger.readAdcSnapshot());
+//   uint16_t raw[bq25155_const::ADC_CHANNEL_COUNT]; spikes.values(raw);
+//   AdcSnapshot clean = charger.scaleAdcFrame(raw);
+template <typename Filter>
+using AdcFilterBank = bq25155_filter::ChannelFilterBank<Filter, bq25155_const::ADC_CHANNEL_COUNT>;
+
+// Fixed charge profile compiled to its register image at build time. Values outside what the
+// setters would accept fail the build instead of being clamped at run time:
+//   using Production = StaticChargeProfile<4200, true, 100000, 20000, ILIMLevel::ILIM_200mA>;
+//   charger.applyChargeImage(Production::image());
+template <uint16_t ChargeVoltage_mV, bool FastCharge, uint32_t ChargeCurrent_uA,
+          uint32_t PrechargeCurrent_uA, ILIMLevel InputCurrentLimit,
+          SafetyTimerLimit SafetyTimer = SafetyTimerLimit::HOURS_3, bool Use2xSafetyTimer = false,
+          bool LedOnWhenChargeDone = true, BatteryChemistry Chemistry = BatteryChemistry::LI_ION_4V2>
+struct StaticChargeProfile {
+    static constexpr uint8_t ilimCode = static_cast<uint8_t>(InputCurrentLimit) & bq25155_const::ILIM_MASK;
+
+    static_assert(ChargeVoltage_mV >= 3600, "charge voltage below 3.6 V");
+    static_assert(ChargeVoltage_mV <= bq25155_const::chemistryMaxChargeVoltage_mV(Chemistry),
+                  "charge voltage above the battery chemistry maximum");
+    static_assert(ChargeCurrent_uA <= bq25155_const::ichgLimit_uA(FastCharge, ilimCode),
+                  "charge current must stay one step below ILIM and within the ICHG range");
+    static_assert(PrechargeCurrent_uA <= bq25155_const::iprechgLimit_uA(
+                      FastCharge, ilimCode, bq25155_const::ichgCode(ChargeCurrent_uA, FastCharge, ilimCode)),
+                  "pre-charge current above ILIM, 40% of ICHG or the IPRECHG range");
+
+    static constexpr ChargeImage image() {
+        return bq25155_const::makeChargeImage(ChargeVoltage_mV, FastCharge, ChargeCurrent_uA,
+                                              PrechargeCurrent_uA, InputCurrentLimit, SafetyTimer,
+                                              Use2xSafetyTimer, LedOnWhenChargeDone, Chemistry);
+    }
+};
+
 class bq25155 {
 public:
+    // Holds LPM high (I2C enabled) for its whole scope; nested sessions are free.
+    //   { bq25155::BusSession bus(charger); ...several register accesses...; }
+    class BusSession {
+    public:
+        explicit BusSession(bq25155 &dev) : _dev(dev) { _dev.beginBusSession(); }
+        ~BusSession() { _dev.endBusSession(); }
+        BusSession(const BusSession &) = delete;
+        BusSession &operator=(const BusSession &) = delete;
+    private:
+        bq25155 &_dev;
+    };
+
+    // Stages every register write made by the setters until commit(), then writes only the
+    // registers that changed, in auto-increment bursts, with a single charge-off window.
+    //   bq25155::ConfigTransaction tx(charger);
+    //   charger.setChargeVoltage(4200); charger.setILIM(ILIMLevel::ILIM_300mA); charger.setITERM(10);
+    //   tx.commit();
+    // Destroying it without commit() discards the staged writes. Requires BQ25155_USE_SHADOW.
+    class ConfigTransaction {
+    public:
+        explicit ConfigTransaction(bq25155 &dev) : _dev(dev), _open(dev.beginConfigTransaction()) {}
+        ~ConfigTransaction() { abort(); }
+        bool commit() {
+            if (!_open) { return false; }
+            _open = false;
+            return _dev.commitConfigTransaction();
+        }
+        void abort() {
+            if (!_open) { return; }
+            _open = false;
+            _dev.abortConfigTransaction();
+        }
+        ConfigTransaction(const ConfigTransaction &) = delete;
+        ConfigTransaction &operator=(const ConfigTransaction &) = delete;
+    private:
+        bq25155 &_dev;
+        bool _open;
+    };
+
+    // Register I/O adapter chosen at compile time (see bq25155_transport.h).
+    using Transport = BQ25155_TRANSPORT;
+
     bq25155();
-    bq25155(TwoWire *wire, uint8_t address = bq25155_const::bq25155_ADDR);
+    // On Arduino a TwoWire* converts implicitly, so bq25155(&Wire1) still works.
+    bq25155(const Transport &bus, uint8_t address = bq25155_const::bq25155_ADDR);
+
+    Transport &transport() { return _bus; }
 
     // begin I2C Communication, and initial settings for configuration pins
+    // With expectedConfigChecksum (a getConfigChecksum() value saved after setup), the
+    // configuration space is burst-read and, when it matches, begin() resumes: /CE follows the
+    // device's charge state and PG is not rewritten. wasConfigResumed() tells the sketch it can
+    // skip applyChargeProfile(). INT_pin is set to INPUT_PULLUP: INT is open drain and only
+    // pulls low. The internal pull-up is weak; add an external one (10 kOhm to the MCU supply)
+    // on long or noisy lines.
     bool begin(uint8_t CHEN_pin = 2, uint8_t INT_pin = 5, uint8_t LPM_pin = 20,
-               BatteryChemistry chemistry = LI_ION_4V2, bool usePGIndicator = true);
+               BatteryChemistry chemistry = LI_ION_4V2, bool usePGIndicator = true,
+               uint32_t expectedConfigChecksum = bq25155_const::CONFIG_CHECKSUM_NONE);
+    bool wasConfigResumed() const;
+    // CRC-16 of the R/W configuration space without the charge-enable and PG state bits.
+    // Free when the shadow is complete; CONFIG_CHECKSUM_NONE if the bus read fails.
+    uint32_t getConfigChecksum();
     void setBatteryChemistry(BatteryChemistry chemistry);
     BatteryChemistry getBatteryChemistry() const;
     
+    // Computes the profile's register image (same clamping as the individual setters), reads
+    // 0x12-0x19 and ICCTRL2 from the device and writes only the bytes that differ, then checks
+    // them with one read-back burst. Re-applying an unchanged profile costs two reads. Charge is
+    // enabled only after the read-back passes; on a failed write it stays off and this returns false.
     bool applyChargeProfile(const ChargeProfile &profile);
+    // Same as applyChargeProfile() for an image compiled ahead of time (StaticChargeProfile or
+    // bq25155_const::compileChargeProfile()). Rejected if its VBAT exceeds the chemistry set in begin().
+    bool applyChargeImage(const ChargeImage &image);
+
+    // --- LPM bus session ---
+    // LPM is raised by the outermost begin and dropped by the matching end.
+    void beginBusSession();
+    void endBusSession();
+
+    // --- Config transaction (see ConfigTransaction) ---
+    // Nested begin calls join the outer transaction; abort discards everything staged.
+    bool beginConfigTransaction();
+    bool commitConfigTransaction();
+    void abortConfigTransaction();
+    bool isConfigTransactionActive() const;
+
+    // --- Charge reconfiguration window ---
+    // STAGED_WINDOW turns every outermost setter chain that needs charge off into an implicit
+    // ConfigTransaction: charge stays on while it reads and stages, and /CE is only held high
+    // around the final burst writes (the verify reads run with charge on). CHARGER_DISABLE, PG and
+    // the termination latch are left alone, so /CE must be wired to CHEN_pin. Explicit
+    // transactions use the same window. Returns false without BQ25155_USE_SHADOW or mid-chain.
+    bool setChargeReconfigMode(ChargeReconfigMode mode);
+    ChargeReconfigMode getChargeReconfigMode() const;
+    // Charge-off time (us, micros()) of the latest window and the longest since reset, in any
+    // mode; applyChargeProfile()/applyChargeImage() windows are included.
+    uint32_t getLastChargeOffWindowUs() const;
+    uint32_t getMaxChargeOffWindowUs() const;
+    void resetChargeOffWindowStats();
+
+    // --- Shadow register file (BQ25155_USE_SHADOW) ---
+    // Drop every cached value; the next access of each register goes to the bus.
+    void invalidateShadow();
+    // Re-read the whole R/W configuration space in a few bursts. Called by begin().
+    bool resyncShadow();
+
+    // --- Bus statistics (BQ25155_ENABLE_BUS_STATS) ---
+    // Inclusive: traffic counts for every instrumented call on the stack, so a read inside
+    // setChargeCurrent -> setPreChargeCurrent -> getChargeCurrent shows up in all three.
+    // All zero when compiled out.
+    BusStats getBusStats(BusApi api) const;
+    BusStats getBusStats() const; // All traffic
+    void resetBusStats();
+
+    // --- Interrupt events ---
+    // enableInterrupt() attaches a FALLING-edge ISR on the INT pin that only marks the event
+    // pending (one bq25155 instance per sketch can own the ISR). Without an attachable pin, call
+    // markInterruptPending() from your own handler. service() then reads FLAG0-3 in one burst,
+    // runs the callback registered for each set bit, and returns the FLAG word (0 if nothing
+    // was pending). service(true) reads even without a pending INT, as a polling fallback.
+    // Only unmasked flags drive INT: see setInterruptMasks(). INT is open drain; begin() enables
+    // the pin's internal pull-up, and without any pull-up the floating line fires spurious edges.
+    bool enableInterrupt();
+    void disableInterrupt();
+    void markInterruptPending() { _intPending = true; }
+    bool isInterruptPending() const { return _intPending; }
+    uint32_t service(bool force = false);
+    bool onEvent(ChargerEvent event, ChargerEventCallback callback, void *context = nullptr);
+    // MASK0-3 as one word (bit set = masked), written/read in a single 4-byte burst.
+    bool setInterruptMasks(uint32_t maskedEvents);
+    uint32_t getInterruptMasks();
+    // FLAG0-3 from the last readAllFLAGS()/service() as one word.
+    uint32_t getCachedFlags() const;
+
+    // --- Chip-reset detection (BQ25155_USE_SHADOW) ---
+    // An HW reset (MR long press, the 14 s watchdog) or a SW reset puts every register back to
+    // its default. checkForChipReset() reads one sentinel: the first register in
+    // RESET_SENTINEL_CANDIDATES whose shadowed value differs from its default. When it reads back
+    // as that default it reads the configuration space once, writes the shadow image (the last
+    // committed configuration, charge enable state included) back in bursts and returns true.
+    // Any other value is not a reset: the shadow entry follows the device and it returns false.
+    // Nothing is read when every candidate is still at its default.
+    // service() runs it every setResetCheckInterval() ms; 0 (the default) turns that off.
+    bool checkForChipReset();
+    void setResetCheckInterval(uint32_t intervalMs);
+    uint16_t getChipResetCount() const;
+
+    // --- Watchdog keeper ---
+    // Every completed I2C transaction feeds the bq25155 watchdogs, so the keeper only tracks the
+    // last successful one and reads STAT0 when nothing else reached the device for
+    // timeout - marginMs. A failed keep-alive returns false and is retried on the next call. The timeout is
+    // taken from the enabled watchdogs when the keeper starts (14 s HWRESET_14S_WD wins over the
+    // 50 s charger watchdog); call it again after changing them. Returns false if neither is on.
+    // service() calls serviceWatchdog(); msUntilKeepAlive() tells a sleeping node when to wake.
+    bool enableWatchdogKeeper(uint32_t marginMs = bq25155_const::WATCHDOG_KEEPER_MARGIN_MS);
+    void disableWatchdogKeeper();
+    bool serviceWatchdog();
+    uint32_t msUntilKeepAlive() const;
+    WatchdogKeeperStats getWatchdogKeeperStats() const;
+
+    // --- FLAG accumulator ---
+    // Every hardware FLAG read (readAllFLAGS(), readFLAGx(), readStatus(true), service(),
+    // ClearAllFlags(), ...) is ORed into a sticky word and into the pending word of each
+    // registered consumer, so several subsystems can share one read without losing events.
+    // All of these are bus-free. Words use the ChargerEvent layout.
+    int8_t registerFlagConsumer();              // Consumer id, or -1 if all slots are taken
+    void unregisterFlagConsumer(uint8_t consumer);
+    uint32_t peekFlags(uint8_t consumer) const; // Pending events, left pending
+    // Returns the pending events selected by mask and clears them for this consumer only.
+    uint32_t fetchFlags(uint8_t consumer, uint32_t mask = 0xFFFFFFFFUL);
+    void ackFlags(uint8_t consumer, uint32_t mask);
+    uint32_t getStickyFlags() const { return _flagSticky; } // Everything seen since clearStickyFlags()
+    void clearStickyFlags() { _flagSticky = 0; }
+
+    // --- Status snapshot ---
+    // STAT0-2 in one 3-byte burst. includeFlags extends the burst to FLAG0-3 (7 bytes), which
+    // clears them in hardware and refreshes the cached FLAGs like readAllFLAGS().
+    StatusSnapshot readStatus(bool includeFlags = false);
 
     // --- Configuration Functions ---
     // --- STAT0 Functions ---
@@ -783,9 +1493,31 @@ public:
     void ClearAllFlags();
     void readAllFLAGS();
     void FaultsDetected(uint8_t* faultsOut);
-    // Non-destructive by default: uses status bits and cached FLAG values.
-    // Set refreshFlags=true to refresh cached FLAGs first (clears hardware FLAG registers).
+    // Non-destructive by default: only the status bits are checked.
+    // Set refreshFlags=true to also read FLAG0-3 (clears the hardware FLAG registers) and check
+    // the FLAGs read by this call. One burst read of STAT0-2 (STAT0-FLAG3 with refreshFlags),
+    // checked against the severe-fault masks; charge enable and PG state come from the shadow.
+    // Returns false when the status read fails; that sample neither trips nor clears.
     bool enforceSafetyFaultPolicy(bool *chargeDisabled = nullptr, bool refreshFlags = false);
+    void setSevereFaultMasks(const FaultMaskTable &masks);
+    FaultMaskTable getSevereFaultMasks() const;
+
+    // --- Fault rules ---
+    // Per-condition debounce and action, independent of enforceSafetyFaultPolicy(). One rule
+    // per condition and source: adding a rule for a condition that already has one replaces it.
+    // Returns the rule index, or -1 if the rule is invalid or the table is full.
+    int8_t addFaultRule(const FaultRule &rule);
+    // Undoes every active action, then empties the table.
+    bool clearFaultRules();
+    void onFaultRule(FaultRuleCallback callback, void *context = nullptr);
+    // One burst read of STAT0-2 (STAT0-FLAG3 with refreshFlags); the work done is proportional
+    // to the watched bits that are set plus the rules still counting. An action is undone once
+    // no active rule asks for it; the most restrictive parameter wins while several are active.
+    // FaultSource::FLAG rules only see FLAGs with refreshFlags=true; otherwise their sample is
+    // clear. Returns the bitmask of active rules (bit i = rule i).
+    uint32_t evaluateFaultRules(bool refreshFlags = false);
+    uint32_t getActiveFaultRules() const { return _faultRuleActive; }
+    uint16_t getFaultRuleTrips(uint8_t index) const;
     bool setFaultAutoDisableFilter(uint8_t faultSamplesToTrip, uint8_t clearSamplesToReset = 1);
     uint8_t getFaultAutoDisableTripCount() const;
     uint8_t getFaultAutoDisableClearCount() const;
@@ -1088,6 +1820,37 @@ public:
     uint16_t readTS(uint8_t Vdecims);
     uint16_t readADCIN(uint8_t Vdecims);
     uint32_t readICHG(uint8_t Vdecims);
+    // One 16-byte burst (ADCCTRL0..IIN_L) + one ILIMCTRL read for a full, consistent frame.
+    AdcSnapshot readAdcSnapshot(uint8_t Vdecims = 0);
+    // Cached scaling context used by every ADC reader: loaded once (two shadowed reads), then
+    // kept current by the writes to ADCCTRL0/ILIMCTRL and by readAdcSnapshot()'s ADCCTRL0 byte.
+    AdcConversionContext getAdcConversionContext();
+    // Scales raw codes (filtered, logged, from an AdcSample) with the cached context, as
+    // readAdcSnapshot() does for a fresh burst. No bus traffic once the context is loaded.
+    AdcSnapshot scaleAdcFrame(const uint16_t (&raw)[bq25155_const::ADC_CHANNEL_COUNT], uint8_t Vdecims = 0);
+    // INT-driven acquisition: sets ADC_CONV_START (manual read rate; other rates wait for their
+    // next conversion) and unmasks ADC_READY. Once ADC_READY reaches the FLAG accumulator (from
+    // service() or any other FLAG read), service() reads the frame in one burst, then runs the
+    // callback and/or sets adcAcquisitionReady(). No fixed delay is needed; call
+    // enableInterrupt() (or markInterruptPending()) so service() knows INT fired. Without INT,
+    // service() and adcAcquisitionReady() check the conversion every ADC_ACQUISITION_FALLBACK_MS.
+    bool startAdcAcquisition(AdcSnapshotCallback callback = nullptr, void *context = nullptr,
+                             uint8_t Vdecims = 0);
+    bool adcAcquisitionReady();
+    bool isAdcAcquisitionPending() const;
+    void cancelAdcAcquisition();
+    // Last completed frame (valid == false before the first one).
+    const AdcSnapshot &getAdcAcquisition() const;
+    // Every successful frame read (readAdcSnapshot(), INT-driven acquisition) is also passed to
+    // the sink as an AdcSample, so a logger can drain it later without touching the bus.
+    // Single-channel readers (readVBAT() ...) do not feed it. nullptr detaches.
+    void setAdcSampleSink(AdcSampleSink sink, void *context = nullptr);
+    template <uint16_t Capacity>
+    void attachAdcSampleRing(AdcSampleRing<Capacity> &ring) {
+        setAdcSampleSink(&AdcSampleRing<Capacity>::pushTo, &ring);
+    }
+    // Samples the sink refused (ring full).
+    uint32_t getAdcSamplesDropped() const;
     // High-level functions for convenience
     // float getVBATVoltage();
 // --- ADCALARM_COMPx Functions ---
@@ -1129,12 +1892,22 @@ public:
     bool setTSVAL(uint16_t TS_THRS_mV, TSThresholdRegister TS_REG);
 // --- DEVICE_ID Functions ---
     uint8_t getDeviceID();
+#ifdef ARDUINO
     String getDeviceIDString();
-// --- Status and Faults (WIP) ---
-//    bq25155_const::ChargeStatus getChargeStatus(); // Uses REG_STAT_0 (0x00)
+#endif
+// --- Charge Status ---
+    // Phase from STAT0/STAT1 and the charge enable bit: no input, charge disabled, TS cold/hot,
+    // VIN OVP or BAT OCP -> NOT_CHARGING; CHARGE_DONE -> CHARGE_DONE; CV -> FASTCHARGE;
+    // otherwise VBAT (ADC) against VLOWV picks PRECHARGE or FASTCHARGE. The phase is only
+    // recomputed when those status bits change (plus a VBAT re-check every
+    // CHARGE_PHASE_VBAT_RECHECK_MS while precharging), so the steady-state cost is the status read.
+    ChargeStatus getChargeStatus();                              // One STAT0-2 burst
+    ChargeStatus updateChargeStatus(const StatusSnapshot &snap); // Feed an existing readStatus()
+    ChargePhaseStats getChargePhaseStats();                      // Bus-free, times up to now
+    void resetChargePhaseStats();
 
 private:
-    TwoWire *_i2cPort; // Pointer to the Wire object
+    Transport _bus; // Register I/O (Wire adapter by default)
     uint8_t _i2cAddress;
     
     // Cached configuration pins
@@ -1143,7 +1916,14 @@ private:
     uint8_t _LPM_pin  = 0xFF;
     BatteryChemistry _batteryChemistry = LI_ION_4V2;
     uint8_t _chargeReconfigDepth = 0;
+    uint8_t _busSessionDepth = 0;
     bool _resumeChargeAfterConfig = false;
+    bool _configResumed = false;
+    ChargeReconfigMode _chargeReconfigMode = ChargeReconfigMode::PER_CALL;
+    bool _reconfigOwnsTransaction = false; // Outermost setter opened the staging transaction
+    uint32_t _chargeOffStartUs = 0;
+    uint32_t _lastChargeOffUs = 0;
+    uint32_t _maxChargeOffUs = 0;
     bool _usePGIndicator = true;
     bool _pgLedOnWhenChargeDone = true;
     bool _pgChargeDoneLatched = false;
@@ -1151,6 +1931,87 @@ private:
     uint8_t _faultClearThreshold = 1;
     uint8_t _faultTripCounter = 0;
     uint8_t _faultClearCounter = 0;
+    FaultMaskTable _severeFaults = bq25155_const::DEFAULT_SEVERE_FAULTS;
+
+    // Fault rule table
+    FaultRule _faultRules[BQ25155_MAX_FAULT_RULES] = {};
+    uint8_t _faultRuleTripCount[BQ25155_MAX_FAULT_RULES] = {};
+    uint8_t _faultRuleClearCount[BQ25155_MAX_FAULT_RULES] = {};
+    uint16_t _faultRuleTrips[BQ25155_MAX_FAULT_RULES] = {};
+    uint8_t _faultRuleByBit[2][32] = {};  // [FaultSource][event bit] -> rule index + 1, 0 if none
+    uint32_t _faultRuleWatch[2] = {};     // Watched bits per FaultSource
+    uint32_t _faultRuleActive = 0;        // Tripped rules
+    uint32_t _faultRuleTracking = 0;      // Inactive rules with a running trip count
+    uint8_t _faultRuleCount = 0;
+    uint8_t _faultActionHeld = 0;         // Bit per FaultAction currently applied
+    bool _faultChargeWasEnabled = false;  // Saved values restored when an action is released
+    uint32_t _faultBaseChargeCurrent_uA = 0;
+    uint32_t _faultIlimChargeCurrent_uA = 0;
+    uint8_t _faultBaseIlim = 0;
+    uint16_t _faultBaseVbatReduction_mV = 0;
+    FaultRuleCallback _faultRuleCallback = nullptr;
+    void *_faultRuleContext = nullptr;
+
+#if BQ25155_USE_SHADOW
+    // Shadow of the R/W configuration registers, indexed by shadowIndex()
+    uint8_t _shadow[bq25155_const::SHADOW_REG_COUNT] = {};
+    uint32_t _shadowValid = 0;
+    // Config transaction staging area (same indexing as _shadow)
+    uint8_t _stage[bq25155_const::SHADOW_REG_COUNT] = {};
+    uint32_t _stageDirty = 0;
+#endif
+    uint8_t _stageDepth = 0;
+    bool _stageEnableCharge = false; // writeChargeImage() staged: commit ends with charge enabled
+
+#if BQ25155_ENABLE_BUS_STATS
+    // Marks an instrumented API as active for its lifetime (see BQ25155_BUS_API).
+    class BusApiScope {
+    public:
+        BusApiScope(bq25155 &dev, BusApi api);
+        ~BusApiScope();
+        BusApiScope(const BusApiScope &) = delete;
+        BusApiScope &operator=(const BusApiScope &) = delete;
+    private:
+        bq25155 &_dev;
+        uint8_t _index;
+        bool _outer;
+        uint32_t _startUs;
+    };
+    BusStats _busStats[bq25155_const::BUS_API_COUNT];
+    BusStats _busStatsTotal;
+    uint32_t _busApiActive = 0;
+#endif
+
+    // Interrupt events (see service())
+    volatile bool _intPending = false;
+    uint32_t _resetCheckIntervalMs = 0;
+    uint32_t _resetCheckLastMs = 0;
+    uint16_t _chipResetCount = 0;
+    AdcConversionContext _adcCtx; // See adcContext()
+
+    // INT-driven ADC acquisition
+    AdcSnapshot _adcAcqResult;
+    AdcSnapshotCallback _adcAcqCallback = nullptr;
+    void *_adcAcqContext = nullptr;
+    uint32_t _adcAcqPollMs = 0;
+    uint8_t _adcAcqDecims = 0;
+    bool _adcAcqPending = false;
+    bool _adcAcqReady = false;
+    bool _adcAcqFlagSeen = false; // ADC_READY ingested while pending, whoever read the FLAGs
+    AdcSampleSink _adcSampleSink = nullptr;
+    void *_adcSampleContext = nullptr;
+    uint32_t _adcSamplesDropped = 0;
+    AdcSnapshot readAdcFrame(uint8_t Vdecims, uint8_t &adcctrl0);
+    bool completeAdcAcquisition();
+    void serviceAdcAcquisition();
+
+    // Watchdog keeper
+    WatchdogKeeperStats _wdKeeper;
+    uint32_t _wdKeeperMarginMs = 0;
+    ChargerEventCallback _eventCallbacks[bq25155_const::CHARGER_EVENT_COUNT] = {};
+    void *_eventContexts[bq25155_const::CHARGER_EVENT_COUNT] = {};
+    static bq25155 *_isrInstance;
+    static void isrTrampoline();
 
     // Cached copies of FLAG registers
     uint8_t cachedFlag0 = 0;
@@ -1158,6 +2019,19 @@ private:
     uint8_t cachedFlag2 = 0;
     uint8_t cachedFlag3 = 0;
 
+    // Charge phase tracker
+    ChargePhaseStats _chgPhase;
+    uint32_t _chgStatusKey = 0xFFFFFFFFUL; // Status bits the phase was last derived from
+    uint32_t _chgLastUpdateMs = 0;
+    uint32_t _chgVbatCheckMs = 0;
+    void accumulateChargePhaseTime(uint32_t nowMs);
+
+    // FLAG accumulator
+    uint32_t _flagSticky = 0;
+    uint32_t _flagPending[BQ25155_MAX_FLAG_CONSUMERS] = {};
+    uint8_t _flagConsumers = 0; // Bit per registered consumer
+    void ingestFlags(uint32_t flags);
+
     // Internal raw-code helpers (typed public API forwards into these).
     bool is_Alarm_TRIG(uint8_t AlarmCh);
     bool setUVLO(uint8_t code);
@@ -1179,23 +2053,51 @@ private:
     float getTSVAL(uint8_t TS_REG);
     bool setTSVAL(uint16_t TS_THRS_mV, uint8_t TS_REG);
     bool refreshPGIndicatorFromState();
+    bool writeChargeImage(const ChargeImage &image);
+    bool applyFaultAction(FaultAction action);
     void latchPGCompletionFromCachedFlags();
     void resetPGLatchForNewChargeCycle();
 
     // --- Low-level I2C access (for debugging or advanced use) ---
     bool writeRegister(uint8_t reg, uint8_t value);
     bool writeRegisterVerify(uint8_t reg, uint8_t value, uint8_t verifyMask = 0xFF);
+    bool writeRegisters(uint8_t startReg, const uint8_t *data, uint8_t len);
+    static uint8_t immediateBits(uint8_t reg);
+#if BQ25155_USE_SHADOW
+    bool stageWrite(uint8_t reg, uint8_t value);
+    bool writeStagedRuns(uint32_t changed, bool chargeOffWindow);
+    bool restoreConfigImage();
+#endif
     uint8_t readRegister(uint8_t reg);
+    uint8_t readRegisterUncached(uint8_t reg);
+    bool readRegisters(uint8_t startReg, uint8_t *buf, uint8_t len);
+    static uint8_t shadowIndex(uint8_t reg);
+    static uint8_t volatileBits(uint8_t reg);
+    uint32_t readConfigSpace(uint8_t *image);
+    static uint16_t configChecksum(const uint8_t *image);
+    static uint32_t chargeRegisterBits();
+    void updateShadow(uint8_t reg, uint8_t value);
+    uint32_t busStatsMicros() const;
+    void noteBusTransaction(uint8_t wireBytes, uint32_t startUs, bool ok);
+    void noteLpmToggle();
     uint16_t readRaw16BitRegister(uint8_t msb_reg, uint8_t lsb_reg);
     uint16_t getChemistryMaxChargeVoltage_mV() const;
     bool enterChargeReconfig();
     bool exitChargeReconfig(bool success);
+    void openChargeOffWindow();
+    void closeChargeOffWindow();
 
     // --- Helper functions for converting values to register bits and vice-versa ---
-    uint16_t KeepDecimals(uint32_t value, uint8_t digits);
+    uint32_t KeepDecimals(uint32_t value, uint8_t digits);
     uint16_t GenADCVRead(uint8_t ADC_DATA_MSB, uint8_t ADC_DATA_LSB, uint8_t KeepDec, bool VRef);
     uint32_t GenADCIRead(uint8_t ADC_DATA_MSB, uint8_t ADC_DATA_LSB, uint8_t KeepDec);
     uint32_t GenADCIPRead(uint8_t ADC_DATA_MSB, uint8_t ADC_DATA_LSB, uint8_t KeepDec);
+    static AdcConversionContext makeAdcContext(uint8_t adcSpeed, uint8_t ilimCode);
+    const AdcConversionContext &adcContext();
+    void noteAdcContextWrite(uint8_t startReg, const uint8_t *data, uint8_t len);
+    uint16_t convertADCVoltage(uint16_t ADC_Reading, const AdcConversionContext &ctx, uint8_t KeepDec, bool VRef);
+    uint32_t convertADCCurrent(uint16_t ADC_Reading, const AdcConversionContext &ctx, uint8_t KeepDec);
+    uint32_t convertADCChargePercent(uint16_t ADC_Reading, const AdcConversionContext &ctx, uint8_t KeepDec);
 };
 
 #endif // BQ25155_H
@@ -0,0 +1,216 @@
+/*
+ * @brief         Fixed-point streaming filters for bq25155's Arduino library
+ * @note          Integer-only, O(1) per sample, state sized at compile time. Filters work on
+ *                raw ADC codes (AdcSample::raw, AdcSnapshot::raw); scale the result once with
+ *                bq25155::scaleAdcFrame(). No division: windows and alphas are powers of two.
+ * @version       1.1.4
+ * @creation date 2026-03-09
+ * @updated date  2026-03-09
+ * @author        jul10199555
+ *
+ * Repo:
+ * https://github.com/jul10199555/bq25155-Arduino-Library
+ *
+ */
+
+#ifndef BQ25155_FILTER_H
+#define BQ25155_FILTER_H
+
+#include "bq25155_port.h"
+
+// Every filter has the same shape, so ChannelFilterBank can hold any of them:
+//   uint16_t update(uint16_t sample);  // feed one raw code, returns the current output
+//   uint16_t value() const;            // last output
+//   bool ready() const;                // output covers a full window / settled history
+//   void reset();                      // the next sample starts over
+namespace bq25155_filter {
+
+// Moving average over the last 2^WindowShift samples: running sum plus a circular history.
+// The first sample fills the whole history, so there is no partial-window division.
+template <uint8_t WindowShift>
+class MovingAverage {
+    static_assert(WindowShift >= 1 && WindowShift <= 7, "Window must be 2 to 128 samples");
+
+public:
+    static constexpr uint8_t WINDOW = (uint8_t)(1U << WindowShift);
+
+    uint16_t update(uint16_t sample) {
+        if (_count == 0) {
+            for (uint8_t i = 0; i < WINDOW; i++) { _history[i] = sample; }
+            _sum = (uint32_t)sample << WindowShift;
+        } else {
+            _sum += sample;
+            _sum -= _history[_next];
+            _history[_next] = sample;
+        }
+        _next = (uint8_t)((_next + 1) & (WINDOW - 1));
+        if (_count < WINDOW) { _count++; }
+        return value();
+    }
+    uint16_t value() const { return (uint16_t)(_sum >> WindowShift); }
+    bool ready() const { return _count >= WINDOW; }
+    void reset() { _count = 0; _next = 0; }
+
+private:
+    uint16_t _history[WINDOW];
+    uint32_t _sum = 0;
+    uint8_t _next = 0;
+    uint8_t _count = 0;
+};
+
+// Exponential moving average with alpha = 1 / 2^Shift, kept with Shift fraction bits:
+//   acc += sample - acc / 2^Shift
+// Settles to within 1% of a step after about 4.6 x 2^Shift samples.
+template <uint8_t Shift>
+class Ema {
+    static_assert(Shift >= 1 && Shift <= 15, "Shift must be 1 to 15");
+
+public:
+    uint16_t update(uint16_t sample) {
+        if (_count == 0) {
+            _acc = (uint32_t)sample << Shift;
+        } else {
+            _acc = _acc - (_acc >> Shift) + sample;
+        }
+        if (_count < SETTLE_SAMPLES) { _count++; }
+        return value();
+    }
+    uint16_t value() const { return (uint16_t)((_acc + (1UL << (Shift - 1))) >> Shift); }
+    bool ready() const { return _count >= SETTLE_SAMPLES; }
+    void reset() { _count = 0; }
+
+private:
+    // 5 time constants, capped so the counter stays a byte.
+    static constexpr uint8_t SETTLE_SAMPLES = (Shift >= 5) ? 255 : (uint8_t)(5U << Shift);
+    uint32_t _acc = 0;
+    uint8_t _count = 0;
+};
+
+// Median of the last 3 or 5 samples: drops single (3) or double (5) spikes without smearing
+// edges. Fixed compare/exchange networks, no sorting loop.
+template <uint8_t Taps>
+class Median {
+    static_assert(Taps == 3 || Taps == 5, "Median supports 3 or 5 taps");
+
+public:
+    uint16_t update(uint16_t sample) {
+        if (_count == 0) {
+            for (uint8_t i = 0; i < Taps; i++) { _history[i] = sample; }
+        } else {
+            _history[_next] = sample;
+        }
+        _next = (uint8_t)((_next + 1 == Taps) ? 0 : _next + 1);
+        if (_count < Taps) { _count++; }
+
+        uint16_t p[Taps];
+        for (uint8_t i = 0; i < Taps; i++) { p[i] = _history[i]; }
+        _value = median(p);
+        return _value;
+    }
+    uint16_t value() const { return _value; }
+    bool ready() const { return _count >= Taps; }
+    void reset() { _count = 0; _next = 0; }
+
+private:
+    static uint16_t median(uint16_t (&p)[3]) {
+        order(p[0], p[1]); order(p[1], p[2]); order(p[0], p[1]);
+        return p[1];
+    }
+    static uint16_t median(uint16_t (&p)[5]) {
+        order(p[0], p[1]); order(p[3], p[4]); order(p[0], p[3]); order(p[1], p[4]);
+        order(p[1], p[2]); order(p[2], p[3]); order(p[1], p[2]);
+        return p[2];
+    }
+    static void order(uint16_t &a, uint16_t &b) {
+        if (a > b) {
+            const uint16_t t = a;
+            a = b;
+            b = t;
+        }
+    }
+
+    uint16_t _history[Taps];
+    uint16_t _value = 0;
+    uint8_t _next = 0;
+    uint8_t _count = 0;
+};
+
+// Tumbling window of 2^WindowShift samples: min, max and mean of the last completed window.
+// Nothing is stored per sample; update() publishes a new triple every WINDOW samples.
+template <uint8_t WindowShift>
+class WindowStats {
+    static_assert(WindowShift >= 1 && WindowShift <= 15, "Window must be 2 to 32768 samples");
+
+public:
+    static constexpr uint16_t WINDOW = (uint16_t)(1U << WindowShift);
+
+    uint16_t update(uint16_t sample) {
+        if (_pending == 0 || sample < _runMin) { _runMin = sample; }
+        if (_pending == 0 || sample > _runMax) { _runMax = sample; }
+        _runSum += sample;
+        if (++_pending == WINDOW) {
+            _min = _runMin;
+            _max = _runMax;
+            _mean = (uint16_t)(_runSum >> WindowShift);
+            _runSum = 0;
+            _pending = 0;
+            _windows++;
+        }
+        return _mean;
+    }
+    uint16_t value() const { return _mean; }
+    // Not min()/max(): the Arduino core defines those as macros.
+    uint16_t minimum() const { return _min; }
+    uint16_t maximum() const { return _max; }
+    uint16_t mean() const { return _mean; }
+    // True right after update() closed a window.
+    bool windowClosed() const { return _windows != 0 && _pending == 0; }
+    uint32_t windows() const { return _windows; }
+    bool ready() const { return _windows != 0; }
+    void reset() {
+        _runSum = 0;
+        _pending = 0;
+        _windows = 0;
+    }
+
+private:
+    uint32_t _runSum = 0;
+    uint32_t _windows = 0;
+    uint16_t _pending = 0;
+    uint16_t _runMin = 0;
+    uint16_t _runMax = 0;
+    uint16_t _min = 0;
+    uint16_t _max = 0;
+    uint16_t _mean = 0;
+};
+
+// One filter per channel. updateFrame() takes anything with a raw[Channels] member
+// (AdcSample, AdcSnapshot); the filtered codes come back as a frame for scaling.
+template <typename Filter, uint8_t Channels>
+class ChannelFilterBank {
+public:
+    void update(const uint16_t (&raw)[Channels]) {
+        for (uint8_t ch = 0; ch < Channels; ch++) { _filters[ch].update(raw[ch]); }
+    }
+    template <typename Frame>
+    void updateFrame(const Frame &frame) { update(frame.raw); }
+
+    uint16_t value(uint8_t channel) const { return _filters[channel].value(); }
+    void values(uint16_t (&raw)[Channels]) const {
+        for (uint8_t ch = 0; ch < Channels; ch++) { raw[ch] = _filters[ch].value(); }
+    }
+    bool ready() const { return _filters[0].ready(); } // Channels are fed together
+    void reset() {
+        for (uint8_t ch = 0; ch < Channels; ch++) { _filters[ch].reset(); }
+    }
+
+    Filter &channel(uint8_t ch) { return _filters[ch]; }
+    const Filter &channel(uint8_t ch) const { return _filters[ch]; }
+
+private:
+    Filter _filters[Channels];
+};
+
+} // namespace bq25155_filter
+
+#endif // BQ25155_FILTER_H
@@ -0,0 +1,56 @@
+/*
+ * @brief         Host defaults for bq25155's platform shim
+ * @note          Only compiled outside the Arduino core; see bq25155_port.h.
+ * @version       1.1.4
+ * @creation date 2026-03-09
+ * @updated date  2026-03-09
+ * @author        jul10199555
+ *
+ * Repo:
+ * https://github.com/jul10199555/bq25155-Arduino-Library
+ *
+ */
+
+#ifndef ARDUINO
+
+#include "bq25155_port.h"
+
+#include <chrono>
+#include <thread>
+
+#if defined(__GNUC__)
+#define BQ25155_PORT_WEAK __attribute__((weak))
+#else
+#define BQ25155_PORT_WEAK
+#endif
+
+namespace bq25155_port {
+
+static std::chrono::steady_clock::time_point portEpoch() {
+    static const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+    return epoch;
+}
+
+BQ25155_PORT_WEAK void pinMode(uint8_t, uint8_t) {}
+
+BQ25155_PORT_WEAK void digitalWrite(uint8_t, uint8_t) {}
+
+BQ25155_PORT_WEAK int digitalRead(uint8_t) { return HIGH; }
+
+BQ25155_PORT_WEAK unsigned long millis() {
+    return (unsigned long)std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - portEpoch()).count();
+}
+
+BQ25155_PORT_WEAK unsigned long micros() {
+    return (unsigned long)std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - portEpoch()).count();
+}
+
+BQ25155_PORT_WEAK void delay(unsigned long ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+} // namespace bq25155_port
+
+#endif // ARDUINO
@@ -0,0 +1,59 @@
+/*
+ * @brief         Platform shim for bq25155's Arduino library
+ * @note          Pulls in the Arduino core when building as an Arduino library,
+ *                otherwise declares the few pin/clock calls the driver uses so the
+ *                same sources build on a host (Linux gateway, unit tests, benchmarks).
+ * @version       1.1.4
+ * @creation date 2026-03-09
+ * @updated date  2026-03-09
+ * @author        jul10199555
+ *
+ * Repo:
+ * https://github.com/jul10199555/bq25155-Arduino-Library
+ *
+ */
+
+#ifndef BQ25155_PORT_H
+#define BQ25155_PORT_H
+
+#ifdef ARDUINO
+
+#include <Arduino.h>
+#include <Wire.h>
+
+#else
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifndef LOW
+#define LOW 0x0
+#endif
+#ifndef HIGH
+#define HIGH 0x1
+#endif
+#ifndef INPUT
+#define INPUT 0x0
+#endif
+#ifndef OUTPUT
+#define OUTPUT 0x1
+#endif
+#ifndef INPUT_PULLUP
+#define INPUT_PULLUP 0x2
+#endif
+
+// Host replacements for the Arduino pin/clock calls. The defaults in bq25155_port.cpp are
+// weak: pins are no-ops (digitalRead returns HIGH) and the clock follows steady_clock.
+// Define any of these in the application to drive real GPIOs or a simulated clock.
+namespace bq25155_port {
+    void pinMode(uint8_t pin, uint8_t mode);
+    void digitalWrite(uint8_t pin, uint8_t value);
+    int digitalRead(uint8_t pin);
+    unsigned long millis();
+    unsigned long micros();
+    void delay(unsigned long ms);
+}
+
+#endif // ARDUINO
+
+#endif // BQ25155_PORT_H
@@ -0,0 +1,141 @@
+/*
+ * @brief         Lock-free single-producer/single-consumer ring for bq25155's Arduino library
+ * @note          Fixed capacity, no heap, no locks. One context pushes (ISR, service task on
+ *                another core), one context pops (loop(), logger). Used for timestamped ADC
+ *                frames (AdcSampleRing), but holds any copyable T.
+ * @version       1.1.4
+ * @creation date 2026-03-09
+ * @updated date  2026-03-09
+ * @author        jul10199555
+ *
+ * Repo:
+ * https://github.com/jul10199555/bq25155-Arduino-Library
+ *
+ */
+
+#ifndef BQ25155_RING_H
+#define BQ25155_RING_H
+
+#include "bq25155_port.h"
+
+// AVR has no <atomic>: the indices are single bytes (atomic loads/stores on an 8-bit core) and
+// a compiler barrier orders the slot copy against the index update. Everywhere else
+// (ESP32 dual core, ARM, host threads) std::atomic acquire/release does the same across cores.
+#if defined(__AVR__)
+#define BQ25155_RING_USE_ATOMIC 0
+#else
+#define BQ25155_RING_USE_ATOMIC 1
+#include <atomic>
+#endif
+
+namespace bq25155_ring {
+
+#if BQ25155_RING_USE_ATOMIC
+typedef uint16_t RingIndex;
+static constexpr uint16_t RING_MAX_CAPACITY = 32768;
+#else
+typedef uint8_t RingIndex;
+static constexpr uint16_t RING_MAX_CAPACITY = 128;
+#endif
+
+// Capacity must be a power of two: the free-running indices wrap on their own and a mask
+// picks the slot, so there is no division and no "one slot wasted" full/empty rule.
+template <typename T, uint16_t Capacity>
+class SpscRing {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+    static_assert(Capacity <= RING_MAX_CAPACITY, "Capacity too large for the ring index type");
+
+public:
+    static constexpr uint16_t capacity() { return Capacity; }
+
+    // Producer side. Returns false (and counts a drop) when the consumer has fallen behind.
+    bool push(const T &item) {
+        const RingIndex head = loadHead(false);
+        const RingIndex tail = loadTail(true);
+        if ((RingIndex)(head - tail) >= Capacity) {
+            _dropped = _dropped + 1; // Producer-owned, read by the consumer as a hint only
+            return false;
+        }
+        _slots[head & (Capacity - 1)] = item;
+        storeHead((RingIndex)(head + 1));
+        return true;
+    }
+
+    // Consumer side. Returns false when the ring is empty.
+    bool pop(T &item) {
+        const RingIndex tail = loadTail(false);
+        const RingIndex head = loadHead(true);
+        if (head == tail) { return false; }
+        item = _slots[tail & (Capacity - 1)];
+        storeTail((RingIndex)(tail + 1));
+        return true;
+    }
+
+    // Consumer side: look at the oldest entry without removing it.
+    bool peek(T &item) const {
+        const RingIndex tail = loadTail(false);
+        const RingIndex head = loadHead(true);
+        if (head == tail) { return false; }
+        item = _slots[tail & (Capacity - 1)];
+        return true;
+    }
+
+    // Either side; exact on the consumer side, a lower bound seen from the producer.
+    uint16_t size() const { return (RingIndex)(loadHead(true) - loadTail(true)); }
+    bool empty() const { return size() == 0; }
+    bool full() const { return size() >= Capacity; }
+
+    // Pushes refused because the ring was full since construction.
+    uint32_t dropped() const { return _dropped; }
+
+    // Adapter for driver hooks taking (const T &, void *context): pass the ring as context.
+    static bool pushTo(const T &item, void *ring) {
+        return static_cast<SpscRing *>(ring)->push(item);
+    }
+
+private:
+    T _slots[Capacity];
+    volatile uint32_t _dropped = 0;
+
+#if BQ25155_RING_USE_ATOMIC
+    std::atomic<RingIndex> _head{0}; // Written by the producer only
+    std::atomic<RingIndex> _tail{0}; // Written by the consumer only
+
+    RingIndex loadHead(bool otherSide) const {
+        return _head.load(otherSide ? std::memory_order_acquire : std::memory_order_relaxed);
+    }
+    RingIndex loadTail(bool otherSide) const {
+        return _tail.load(otherSide ? std::memory_order_acquire : std::memory_order_relaxed);
+    }
+    void storeHead(RingIndex value) { _head.store(value, std::memory_order_release); }
+    void storeTail(RingIndex value) { _tail.store(value, std::memory_order_release); }
+#else
+    volatile RingIndex _head = 0;
+    volatile RingIndex _tail = 0;
+
+    static void barrier() { __asm__ __volatile__("" ::: "memory"); }
+
+    RingIndex loadHead(bool) const {
+        const RingIndex value = _head;
+        barrier(); // Slot reads stay after the index read
+        return value;
+    }
+    RingIndex loadTail(bool) const {
+        const RingIndex value = _tail;
+        barrier();
+        return value;
+    }
+    void storeHead(RingIndex value) {
+        barrier(); // Slot writes land before the index publishes them
+        _head = value;
+    }
+    void storeTail(RingIndex value) {
+        barrier();
+        _tail = value;
+    }
+#endif
+};
+
+} // namespace bq25155_ring
+
+#endif // BQ25155_RING_H
@@ -0,0 +1,206 @@
+/*
+ * @brief         Bus transports for bq25155's Arduino library
+ * @note          Register I/O adapters selected at compile time (no virtual dispatch).
+ * @version       1.1.4
+ * @creation date 2026-03-09
+ * @updated date  2026-03-09
+ * @author        jul10199555
+ *
+ * Repo:
+ * https://github.com/jul10199555/bq25155-Arduino-Library
+ *
+ */
+
+#ifndef BQ25155_TRANSPORT_H
+#define BQ25155_TRANSPORT_H
+
+#include "bq25155_port.h"
+
+#if !defined(ARDUINO) && defined(__linux__)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+#endif
+
+// A transport is any class with these members (called directly, so they inline):
+//   bool begin();                                                   // bring the bus up
+//   bool probe(uint8_t addr);                                       // true if addr ACKs
+//   bool write(uint8_t addr, uint8_t reg, const uint8_t *data, uint8_t len);
+//        -> one transaction: START addr+W reg data[0..len-1] STOP
+//   bool read(uint8_t addr, uint8_t reg, uint8_t *buf, uint8_t len);
+//        -> START addr+W reg, repeated START addr+R buf[0..len-1] STOP
+// The driver splits bursts to BQ25155_I2C_MAX_BURST before calling write()/read().
+//
+// The driver uses BQ25155_TRANSPORT (default: TwoWireBus on Arduino, LinuxI2CBus on
+// Linux hosts, MemoryBus elsewhere). To plug in your own class, define both
+//   -DBQ25155_TRANSPORT_HEADER='"my_bus.h"' -DBQ25155_TRANSPORT=MyBus
+// for the library and the sketch/application alike.
+#ifdef BQ25155_TRANSPORT_HEADER
+#include BQ25155_TRANSPORT_HEADER
+#endif
+
+namespace bq25155_bus {
+
+#ifdef ARDUINO
+// Arduino Wire adapter. Implicitly constructible from TwoWire* so bq25155(&Wire1) keeps working.
+class TwoWireBus {
+public:
+    TwoWireBus(TwoWire *wire = &Wire) : _wire(wire) {}
+
+    bool begin() {
+        _wire->begin();
+        return true;
+    }
+
+    bool probe(uint8_t addr) {
+        _wire->beginTransmission(addr);
+        return (_wire->endTransmission() == 0);
+    }
+
+    bool write(uint8_t addr, uint8_t reg, const uint8_t *data, uint8_t len) {
+        _wire->beginTransmission(addr);
+        _wire->write(reg);
+        for (uint8_t i = 0; i < len; i++) {
+            _wire->write(data[i]);
+        }
+        return (_wire->endTransmission() == 0);
+    }
+
+    bool read(uint8_t addr, uint8_t reg, uint8_t *buf, uint8_t len) {
+        _wire->beginTransmission(addr);
+        _wire->write(reg);
+        if (_wire->endTransmission(false) != 0) { return false; } // Send restart
+
+        if (_wire->requestFrom(addr, (size_t)len) != len) { return false; }
+        for (uint8_t i = 0; i < len; i++) {
+            if (!_wire->available()) { return false; }
+            buf[i] = _wire->read();
+        }
+        return true;
+    }
+
+    TwoWire *wire() const { return _wire; }
+
+private:
+    TwoWire *_wire;
+};
+#endif // ARDUINO
+
+#if !defined(ARDUINO) && defined(__linux__)
+// Linux i2c-dev adapter: each read()/write() is a single I2C_RDWR ioctl, so the register
+// address and the data share one transaction (repeated start on reads), as on Wire.
+// The device node is opened by begin(); copies start closed and open their own handle.
+class LinuxI2CBus {
+public:
+    explicit LinuxI2CBus(const char *device = "/dev/i2c-1") : _device(device), _fd(-1) {}
+    LinuxI2CBus(const LinuxI2CBus &other) : _device(other._device), _fd(-1) {}
+    LinuxI2CBus &operator=(const LinuxI2CBus &) = delete;
+    ~LinuxI2CBus() { close(); }
+
+    bool begin() {
+        if (_fd >= 0) { return true; }
+        _fd = ::open(_device, O_RDWR);
+        return (_fd >= 0);
+    }
+
+    void close() {
+        if (_fd >= 0) {
+            ::close(_fd);
+            _fd = -1;
+        }
+    }
+
+    bool probe(uint8_t addr) {
+        uint8_t reg = 0x00;
+        return transfer(addr, &reg, 1, nullptr, 0);
+    }
+
+    bool write(uint8_t addr, uint8_t reg, const uint8_t *data, uint8_t len) {
+        uint8_t frame[1 + 255];
+        frame[0] = reg;
+        for (uint8_t i = 0; i < len; i++) {
+            frame[1 + i] = data[i];
+        }
+        return transfer(addr, frame, (uint16_t)(len + 1), nullptr, 0);
+    }
+
+    bool read(uint8_t addr, uint8_t reg, uint8_t *buf, uint8_t len) {
+        return transfer(addr, &reg, 1, buf, len);
+    }
+
+    int fd() const { return _fd; }
+
+private:
+    bool transfer(uint8_t addr, uint8_t *out, uint16_t outLen, uint8_t *in, uint16_t inLen) {
+        if (_fd < 0) { return false; }
+        struct i2c_msg msgs[2];
+        msgs[0].addr = addr;
+        msgs[0].flags = 0;
+        msgs[0].len = outLen;
+        msgs[0].buf = out;
+        msgs[1].addr = addr;
+        msgs[1].flags = I2C_M_RD;
+        msgs[1].len = inLen;
+        msgs[1].buf = in;
+
+        struct i2c_rdwr_ioctl_data xfer;
+        xfer.msgs = msgs;
+        xfer.nmsgs = (inLen != 0) ? 2 : 1;
+        return (::ioctl(_fd, I2C_RDWR, &xfer) == (int)xfer.nmsgs);
+    }
+
+    const char *_device;
+    int _fd;
+};
+#endif // !ARDUINO && __linux__
+
+// In-memory register file: 256 bytes, auto-incrementing address pointer, no side effects.
+// Useful to exercise the driver without hardware; reach it through bq25155::transport().
+class MemoryBus {
+public:
+    MemoryBus() : _present(true) {
+        for (uint16_t i = 0; i < 256; i++) { _regs[i] = 0x00; }
+    }
+
+    bool begin() { return true; }
+    bool probe(uint8_t) { return _present; }
+
+    bool write(uint8_t, uint8_t reg, const uint8_t *data, uint8_t len) {
+        if (!_present) { return false; }
+        for (uint8_t i = 0; i < len; i++) {
+            _regs[(uint8_t)(reg + i)] = data[i];
+        }
+        return true;
+    }
+
+    bool read(uint8_t, uint8_t reg, uint8_t *buf, uint8_t len) {
+        if (!_present) { return false; }
+        for (uint8_t i = 0; i < len; i++) {
+            buf[i] = _regs[(uint8_t)(reg + i)];
+        }
+        return true;
+    }
+
+    uint8_t *registers() { return _regs; }
+    void setPresent(bool present) { _present = present; } // false: NACK everything
+
+private:
+    uint8_t _regs[256];
+    bool _present;
+};
+
+} // namespace bq25155_bus
+
+#ifndef BQ25155_TRANSPORT
+#if defined(ARDUINO)
+#define BQ25155_TRANSPORT bq25155_bus::TwoWireBus
+#elif defined(__linux__)
+#define BQ25155_TRANSPORT bq25155_bus::LinuxI2CBus
+#else
+#define BQ25155_TRANSPORT bq25155_bus::MemoryBus
+#endif
+#endif
+
+#endif // BQ25155_TRANSPORT_H